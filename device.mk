@@ -1154,6 +1154,7 @@ ifneq (,$(filter eng, $(TARGET_BUILD_VARIANT)))
 PRODUCT_PACKAGES_DEBUG += BatteryStatsViewer
 endif
 PRODUCT_PACKAGES += dump_power_gs201.sh
+PRODUCT_PACKAGES += powerstats_dump.gs201
 
 # Install product specific framework compatibility matrix
 # (TODO: b/169535506) This includes the FCM for system_ext and product partition.
@@ -10,6 +10,12 @@ for f in /sys/devices/platform/acpm_stats/*_stats ; do
   cat $f
 done
 
+echo "\n------ PowerStats providers ------"
+/vendor/bin/powerstats_dump.gs201 --providers
+
+echo "\n------ PowerStats rail power ------"
+/vendor/bin/powerstats_dump.gs201 --power 0
+
 echo "\n------ CPU PM stats ------"
 cat "/sys/devices/system/cpu/cpupm/cpupm/time_in_state"
 
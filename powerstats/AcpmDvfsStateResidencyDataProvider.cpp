@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AcpmDvfsStateResidencyDataProvider.h"
+
+#include "DecimalScanner.h"
+
+#include <android-base/file.h>
+#include <android-base/logging.h>
+#include <android-base/strings.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+// Number of space separated fields in an fvp_stats state line, and the fields holding the
+// entry count and the duration.
+static constexpr size_t kStateFields = 7;
+static constexpr size_t kCountField = 3;
+static constexpr size_t kDurationField = 6;
+
+static std::string_view trim(std::string_view s) {
+    const size_t begin = s.find_first_not_of(" \t\r\n");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    const size_t end = s.find_last_not_of(" \t\r\n");
+    return s.substr(begin, end - begin + 1);
+}
+
+static bool parseUint(std::string_view s, uint64_t *out) {
+    size_t len = 0;
+    *out = parseDecimal(s, &len);
+    return !s.empty() && len == s.size();
+}
+
+AcpmDvfsStateResidencyDataProvider::AcpmDvfsStateResidencyDataProvider(
+        std::shared_ptr<AcpmStatsSnapshot> snapshot, uint64_t clockRate, std::vector<Config> cfgs)
+    : mSnapshot(std::move(snapshot)), mClockRate(clockRate), mPowerEntities(std::move(cfgs)) {}
+
+std::vector<AcpmDvfsStateResidencyDataProvider::Config>
+AcpmDvfsStateResidencyDataProvider::cpufreqConfigs(
+        const std::vector<std::pair<std::string, std::string>> &cpuPolicyToPath) {
+    std::vector<Config> cfgs;
+    for (const auto &[powerEntity, path] : cpuPolicyToPath) {
+        const std::string freqPath = path + "/time_in_state";
+        std::string content;
+        if (!::android::base::ReadFileToString(freqPath, &content)) {
+            PLOG(ERROR) << __func__ << ":Failed to read file " << freqPath;
+            continue;
+        }
+
+        std::vector<std::pair<std::string, std::string>> states;
+        for (const auto &line : ::android::base::Split(content, "\n")) {
+            std::string_view freq = trim(line);
+            freq = freq.substr(0, freq.find(' '));
+            if (freq.size() <= 3) {
+                continue;
+            }
+            states.emplace_back(std::string(freq.substr(0, freq.size() - 3)) + "MHz",
+                                std::string(freq));
+        }
+        states.emplace_back("0MHz", "0");
+        cfgs.push_back({powerEntity, std::move(states)});
+    }
+    return cfgs;
+}
+
+int32_t AcpmDvfsStateResidencyDataProvider::matchEntity(std::string_view line) const {
+    for (int32_t i = 0; i < mPowerEntities.size(); i++) {
+        if (mPowerEntities[i].powerEntity == trim(line)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int32_t AcpmDvfsStateResidencyDataProvider::matchState(std::string_view line,
+                                                       const Config &powerEntity) const {
+    const std::string_view trimmed = trim(line);
+    for (int32_t i = 0; i < powerEntity.states.size(); i++) {
+        const std::string &key = powerEntity.states[i].second;
+        if (trimmed.substr(0, key.size()) == key) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool AcpmDvfsStateResidencyDataProvider::parseState(std::string_view line, uint64_t *duration,
+                                                    uint64_t *count) const {
+    std::string_view parts[kStateFields];
+    size_t numParts = 0;
+    size_t pos = 0;
+    while (true) {
+        const size_t end = line.find(' ', pos);
+        if (numParts == kStateFields) {
+            return false;
+        }
+        parts[numParts++] = line.substr(pos, end == std::string_view::npos ? end : end - pos);
+        if (end == std::string_view::npos) {
+            break;
+        }
+        pos = end + 1;
+    }
+
+    return numParts == kStateFields && parseUint(trim(parts[kCountField]), count) &&
+           parseUint(trim(parts[kDurationField]), duration);
+}
+
+bool AcpmDvfsStateResidencyDataProvider::parse(
+        std::string_view buf,
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) const {
+    for (const Config &powerEntity : mPowerEntities) {
+        std::vector<StateResidency> stateResidency(powerEntity.states.size());
+        for (int32_t i = 0; i < stateResidency.size(); i++) {
+            stateResidency[i].id = i;
+        }
+        residencies->emplace(powerEntity.powerEntity, std::move(stateResidency));
+    }
+
+    auto it = residencies->end();
+    int32_t powerEntityIndex = -1;
+    size_t pos = 0;
+    while (pos < buf.size()) {
+        size_t end = buf.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = buf.size();
+        }
+        const std::string_view line = buf.substr(pos, end - pos);
+        pos = end + 1;
+
+        // Assign new index only when a new valid entity is encountered.
+        int32_t temp = matchEntity(line);
+        if (temp >= 0) {
+            powerEntityIndex = temp;
+            it = residencies->find(mPowerEntities[powerEntityIndex].powerEntity);
+        }
+
+        if (it == residencies->end()) {
+            continue;
+        }
+
+        int32_t stateId = matchState(line, mPowerEntities[powerEntityIndex]);
+        if (stateId < 0) {
+            continue;
+        }
+
+        uint64_t duration, count;
+        if (!parseState(line, &duration, &count)) {
+            LOG(ERROR) << "Failed to parse duration and count from [" << line << "]";
+            return false;
+        }
+        it->second[stateId].totalTimeInStateMs = duration / mClockRate;
+        it->second[stateId].totalStateEntryCount = count;
+    }
+
+    return true;
+}
+
+bool AcpmDvfsStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    return mSnapshot->visit(AcpmStatsSnapshot::FVP, [this, residencies](std::string_view buf) {
+        return parse(buf, residencies);
+    });
+}
+
+std::unordered_map<std::string, std::vector<State>> AcpmDvfsStateResidencyDataProvider::getInfo() {
+    std::unordered_map<std::string, std::vector<State>> info;
+    for (const Config &powerEntity : mPowerEntities) {
+        std::vector<State> stateInfo(powerEntity.states.size());
+        for (int32_t i = 0; i < powerEntity.states.size(); i++) {
+            stateInfo[i] = {.id = i, .name = powerEntity.states[i].first};
+        }
+        info.emplace(powerEntity.powerEntity, std::move(stateInfo));
+    }
+    return info;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AcpmStateResidencyDataProvider.h"
+
+#include <android-base/logging.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+AcpmStateResidencyDataProvider::AcpmStateResidencyDataProvider(
+        std::shared_ptr<AcpmStatsSnapshot> snapshot, AcpmStatsSnapshot::Node node,
+        std::vector<PowerEntityConfig> configs)
+    : mSnapshot(std::move(snapshot)), mNode(node), mParser(std::move(configs)) {}
+
+bool AcpmStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    return mSnapshot->visit(mNode, [this, residencies](std::string_view buf) {
+        if (!mParser.parse(buf, residencies)) {
+            LOG(ERROR) << __func__ << ": failed to parse " << mSnapshot->getPath(mNode);
+            return false;
+        }
+        return true;
+    });
+}
+
+std::unordered_map<std::string, std::vector<State>> AcpmStateResidencyDataProvider::getInfo() {
+    return mParser.getInfo();
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
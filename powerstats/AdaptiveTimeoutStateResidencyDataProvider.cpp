@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AdaptiveTimeoutStateResidencyDataProvider.h"
+
+#include <android-base/logging.h>
+
+#include <algorithm>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+// The timeout is recomputed after this many successful reads.
+static constexpr size_t kUpdatePeriod = 8;
+// The timeout is the slowest of the recent latencies, plus all of it.
+static constexpr int64_t kMarginPercent = 100;
+// Changes below this fraction of the current timeout do not recreate the provider.
+static constexpr int64_t kHysteresisPercent = 25;
+
+AdaptiveTimeoutStateResidencyDataProvider::AdaptiveTimeoutStateResidencyDataProvider(
+        Factory factory, std::chrono::milliseconds minTimeout,
+        std::chrono::milliseconds maxTimeout)
+    : mFactory(std::move(factory)),
+      kMinTimeout(minTimeout),
+      kMaxTimeout(std::max(minTimeout, maxTimeout)),
+      mTimeout(kMaxTimeout),
+      mProvider(mFactory(kMaxTimeout)) {}
+
+void AdaptiveTimeoutStateResidencyDataProvider::setTimeoutLocked(
+        std::chrono::milliseconds timeout) {
+    timeout = std::clamp(timeout, kMinTimeout, kMaxTimeout);
+    const auto change = timeout > mTimeout ? timeout - mTimeout : mTimeout - timeout;
+    if (change * 100 < mTimeout * kHysteresisPercent) {
+        return;
+    }
+    LOG(INFO) << __func__ << ": timeout " << mTimeout.count() << "ms -> " << timeout.count()
+              << "ms";
+    mTimeout = timeout;
+    mProvider = mFactory(mTimeout);
+}
+
+std::chrono::milliseconds AdaptiveTimeoutStateResidencyDataProvider::getTargetTimeoutLocked()
+        const {
+    const auto slowest = *std::max_element(mLatencies, mLatencies + mNumLatencies);
+    return std::chrono::ceil<std::chrono::milliseconds>(slowest * (100 + kMarginPercent) / 100);
+}
+
+bool AdaptiveTimeoutStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    std::lock_guard<std::mutex> lock(mLock);
+    if (!mProvider) {
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool ok = mProvider->getStateResidencies(residencies);
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+
+    if (!ok) {
+        // Likely timed out. The provider may still be waiting on the remote, so it is left alone
+        // until a read completes, and measuring starts again.
+        mNumLatencies = 0;
+        mNextLatency = 0;
+        mReadsSinceUpdate = 0;
+        mRaisePending = true;
+        return false;
+    }
+
+    mLatencies[mNextLatency] = latency;
+    mNextLatency = (mNextLatency + 1) % kWindow;
+    mNumLatencies = std::min(mNumLatencies + 1, kWindow);
+    if (mRaisePending) {
+        // The read completed, so the provider can be recreated without waiting on the remote.
+        mRaisePending = false;
+        mReadsSinceUpdate = 0;
+        setTimeoutLocked(mTimeout * 2);
+    } else if (++mReadsSinceUpdate >= kUpdatePeriod) {
+        mReadsSinceUpdate = 0;
+        setTimeoutLocked(getTargetTimeoutLocked());
+    }
+    return true;
+}
+
+std::unordered_map<std::string, std::vector<State>>
+AdaptiveTimeoutStateResidencyDataProvider::getInfo() {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mProvider ? mProvider->getInfo()
+                     : std::unordered_map<std::string, std::vector<State>>();
+}
+
+std::chrono::milliseconds AdaptiveTimeoutStateResidencyDataProvider::getTimeout() {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mTimeout;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AsyncStateResidencyDataProvider.h"
+
+#include <android-base/logging.h>
+
+#include <pthread.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+AsyncStateResidencyDataProvider::AsyncStateResidencyDataProvider(
+        const std::string &name, std::unique_ptr<PowerStats::IStateResidencyDataProvider> provider,
+        std::chrono::milliseconds refreshInterval, std::chrono::milliseconds maxAge)
+    : mProvider(std::move(provider)),
+      kRefreshInterval(refreshInterval),
+      kMaxAge(maxAge),
+      mCounters(getProviderCounters(name)) {
+    mThread = std::thread([this, name] {
+        // Thread names are limited to 15 characters.
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+        readerLoop();
+    });
+}
+
+AsyncStateResidencyDataProvider::~AsyncStateResidencyDataProvider() {
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mStopping = true;
+    }
+    mCv.notify_all();
+    mReadCv.notify_all();
+    mThread.join();
+}
+
+void AsyncStateResidencyDataProvider::readerLoop() {
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true) {
+        auto ready = [this] { return mStopping || mRefreshRequested; };
+        if (kRefreshInterval.count() > 0) {
+            mCv.wait_for(lock, kRefreshInterval, ready);
+        } else {
+            mCv.wait(lock, ready);
+        }
+        if (mStopping) {
+            return;
+        }
+        mRefreshRequested = false;
+
+        lock.unlock();
+        std::unordered_map<std::string, std::vector<StateResidency>> sample;
+        bool status;
+        {
+            ScopedProviderCall call(mCounters);
+            status = mProvider->getStateResidencies(&sample);
+            if (!status) {
+                call.setFailed();
+            }
+        }
+        lock.lock();
+
+        // Keep serving the previous sample if a read fails after a successful one.
+        if (status || !mSampleStatus) {
+            mSample = std::move(sample);
+            mSampleStatus = status;
+            mSampleTime = std::chrono::steady_clock::now();
+            mHasSample = true;
+        }
+        mNumReads++;
+        mReadCv.notify_all();
+    }
+}
+
+bool AsyncStateResidencyDataProvider::isSampleFreshLocked() const {
+    return mHasSample && std::chrono::steady_clock::now() - mSampleTime <= kMaxAge;
+}
+
+bool AsyncStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    std::unique_lock<std::mutex> lock(mLock);
+    mRefreshRequested = true;
+    mCv.notify_one();
+
+    if (kMaxAge.count() > 0 && !isSampleFreshLocked()) {
+        // The read just requested is bounded by the wrapped provider, e.g. its AoC timeout. A
+        // read already in flight completes sooner and is just as fresh.
+        const uint64_t numReads = mNumReads;
+        mReadCv.wait(lock, [&] { return mStopping || mNumReads != numReads; });
+        if (!isSampleFreshLocked()) {
+            LOG(WARNING) << __func__ << ": failed to read a sample within " << kMaxAge.count()
+                         << "ms";
+            return false;
+        }
+    }
+
+    if (!mHasSample) {
+        LOG(WARNING) << __func__ << ": no sample available yet";
+        return false;
+    }
+
+    mCounters->recordSampleAge(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - mSampleTime));
+    residencies->insert(mSample.begin(), mSample.end());
+    return mSampleStatus;
+}
+
+std::unordered_map<std::string, std::vector<State>> AsyncStateResidencyDataProvider::getInfo() {
+    return mProvider->getInfo();
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BufferedStateResidencyDataProvider.h"
+
+#include "FileUtils.h"
+
+#include <android-base/logging.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+BufferedStateResidencyDataProvider::BufferedStateResidencyDataProvider(
+        std::string path, std::vector<PowerEntityConfig> configs)
+    : mParser(std::move(configs)), mFile(std::move(path)) {}
+
+bool BufferedStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    std::lock_guard<std::mutex> lock(mLock);
+    size_t used = 0;
+    if (!mFile.read(&mBuffer, &used)) {
+        return false;
+    }
+
+    if (!mParser.parse(std::string_view(mBuffer.data(), used), residencies)) {
+        LOG(ERROR) << __func__ << ": failed to parse " << mFile.getPath();
+        return false;
+    }
+    return true;
+}
+
+std::unordered_map<std::string, std::vector<State>>
+BufferedStateResidencyDataProvider::getInfo() {
+    return mParser.getInfo();
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CoalescedEnergyMeterDataProvider.h"
+
+#include <android-base/logging.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+CoalescedEnergyMeterDataProvider::CoalescedEnergyMeterDataProvider(
+        std::unique_ptr<PowerStats::IEnergyMeterDataProvider> meter,
+        std::chrono::milliseconds window)
+    : mMeter(std::move(meter)), kWindow(window), mCounters(getProviderCounters("ODPM")) {
+    if (!mMeter->getEnergyMeterInfo(&mChannels).isOk()) {
+        LOG(ERROR) << __func__ << ":Failed to get energy meter info";
+        mChannels.clear();
+    }
+    for (const Channel &c : mChannels) {
+        mChannelIds.emplace(c.name, c.id);
+    }
+}
+
+int32_t CoalescedEnergyMeterDataProvider::getChannelId(const std::string &name) const {
+    const auto it = mChannelIds.find(name);
+    return it == mChannelIds.end() ? -1 : it->second;
+}
+
+ndk::ScopedAStatus CoalescedEnergyMeterDataProvider::sampleLocked(
+        std::chrono::milliseconds maxAge) {
+    const auto now = std::chrono::steady_clock::now();
+    if (mHasSnapshot && now - mSnapshotTime < maxAge) {
+        return ndk::ScopedAStatus::ok();
+    }
+
+    std::vector<EnergyMeasurement> snapshot;
+    ndk::ScopedAStatus status = mMeter->readEnergyMeter({}, &snapshot);
+    if (!status.isOk()) {
+        LOG(ERROR) << __func__ << ":Failed to read energy meter";
+        return status;
+    }
+
+    mSnapshotIndex.clear();
+    for (int32_t i = 0; i < snapshot.size(); i++) {
+        const int32_t id = snapshot[i].id;
+        if (id < 0) {
+            continue;
+        }
+        if (id >= mSnapshotIndex.size()) {
+            mSnapshotIndex.resize(id + 1, -1);
+        }
+        mSnapshotIndex[id] = i;
+    }
+    mSnapshot = std::move(snapshot);
+    mSnapshotTime = now;
+    mHasSnapshot = true;
+    return ndk::ScopedAStatus::ok();
+}
+
+ndk::ScopedAStatus CoalescedEnergyMeterDataProvider::readEnergyMeter(
+        const std::vector<int32_t> &in_channelIds, std::vector<EnergyMeasurement> *_aidl_return) {
+    return readEnergyMeter(in_channelIds, _aidl_return, kWindow);
+}
+
+ndk::ScopedAStatus CoalescedEnergyMeterDataProvider::readEnergyMeter(
+        const std::vector<int32_t> &in_channelIds, std::vector<EnergyMeasurement> *_aidl_return,
+        std::chrono::milliseconds maxAge) {
+    ScopedProviderCall call(mCounters);
+    std::lock_guard<std::mutex> lock(mLock);
+    ndk::ScopedAStatus status = sampleLocked(maxAge);
+    if (!status.isOk()) {
+        // The IIO meter does not go through the file helpers, count its failures here.
+        countReadError();
+        call.setFailed();
+        return status;
+    }
+
+    if (in_channelIds.empty()) {
+        *_aidl_return = mSnapshot;
+        return ndk::ScopedAStatus::ok();
+    }
+
+    _aidl_return->reserve(in_channelIds.size());
+    for (const int32_t id : in_channelIds) {
+        if (id < 0 || id >= mSnapshotIndex.size() || mSnapshotIndex[id] < 0) {
+            _aidl_return->clear();
+            return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+        }
+        _aidl_return->push_back(mSnapshot[mSnapshotIndex[id]]);
+    }
+    return ndk::ScopedAStatus::ok();
+}
+
+ndk::ScopedAStatus CoalescedEnergyMeterDataProvider::getEnergyMeterInfo(
+        std::vector<Channel> *_aidl_return) {
+    *_aidl_return = mChannels;
+    return ndk::ScopedAStatus::ok();
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
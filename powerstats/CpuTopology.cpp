@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CpuTopology.h"
+
+#include "FileUtils.h"
+
+#include <android-base/file.h>
+#include <android-base/logging.h>
+#include <android-base/parseint.h>
+#include <android-base/strings.h>
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+bool CpuTopology::discover(const std::string &cpufreqDir) {
+    mClusters.clear();
+    const std::string dirPath = remapPath(cpufreqDir);
+    std::unique_ptr<DIR, decltype(&closedir)> dir(opendir(dirPath.c_str()), closedir);
+    if (!dir) {
+        PLOG(ERROR) << __func__ << ":Failed to open " << dirPath;
+        return false;
+    }
+
+    while (dirent *ent = readdir(dir.get())) {
+        const std::string_view name(ent->d_name);
+        uint32_t policy;
+        if (!::android::base::StartsWith(name, "policy") ||
+            !::android::base::ParseUint(std::string(name.substr(6)), &policy)) {
+            continue;
+        }
+        Cluster cluster = {.policyDir = cpufreqDir + "/" + std::string(name)};
+        std::string related;
+        if (!::android::base::ReadFileToString(
+                    remapPath(cluster.policyDir + "/related_cpus"), &related)) {
+            PLOG(ERROR) << __func__ << ":Failed to read CPUs of " << cluster.policyDir;
+            continue;
+        }
+        for (const std::string &token : ::android::base::Tokenize(related, " \n")) {
+            uint32_t cpu;
+            if (::android::base::ParseUint(token, &cpu)) {
+                cluster.cpus.push_back(cpu);
+            }
+        }
+        if (cluster.cpus.empty()) {
+            LOG(ERROR) << __func__ << ": no CPUs in " << cluster.policyDir;
+            continue;
+        }
+        if (cluster.cpus.size() > kMaxCoresPerCluster) {
+            // CORE<n><i> would be ambiguous, e.g. CORE110 for cluster 1 core 10 and cluster 11.
+            LOG(ERROR) << __func__ << ": too many CPUs in " << cluster.policyDir;
+            mClusters.clear();
+            return false;
+        }
+        std::sort(cluster.cpus.begin(), cluster.cpus.end());
+        mClusters.push_back(std::move(cluster));
+    }
+
+    std::sort(mClusters.begin(), mClusters.end(), [](const Cluster &a, const Cluster &b) {
+        return a.cpus.front() < b.cpus.front();
+    });
+    return !mClusters.empty();
+}
+
+std::string CpuTopology::getClusterName(size_t cluster) {
+    return "CLUSTER" + std::to_string(cluster);
+}
+
+std::string CpuTopology::getCoreName(size_t cluster, size_t core) {
+    return "CORE" + std::to_string(cluster) + std::to_string(core);
+}
+
+bool containsWord(std::string_view text, std::string_view name) {
+    auto isWordChar = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    };
+    for (size_t pos = text.find(name); pos != std::string_view::npos;
+         pos = text.find(name, pos + 1)) {
+        const size_t end = pos + name.size();
+        if ((pos == 0 || !isWordChar(text[pos - 1])) &&
+            (end == text.size() || !isWordChar(text[end]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EventDrivenStateResidencyDataProvider.h"
+
+#include <android-base/logging.h>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+using ::android::base::unique_fd;
+
+EventDrivenStateResidencyDataProvider::EventDrivenStateResidencyDataProvider(
+        const std::string &name, std::unique_ptr<PowerStats::IStateResidencyDataProvider> provider,
+        const std::string &watchPath, std::chrono::milliseconds minInterval,
+        std::chrono::milliseconds maxInterval)
+    : kName(name),
+      mProvider(std::move(provider)),
+      kWatchPath(watchPath),
+      kMinInterval(minInterval),
+      kMaxInterval(std::max(minInterval, maxInterval)),
+      mCounters(getProviderCounters(name)) {
+    mStopFd.reset(eventfd(0, EFD_CLOEXEC));
+    mEpollFd.reset(epoll_create1(EPOLL_CLOEXEC));
+    if (mStopFd < 0 || mEpollFd < 0) {
+        PLOG(ERROR) << __func__ << ":Failed to create epoll for " << name;
+        mStopFd.reset();
+        mEpollFd.reset();
+    } else {
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = mStopFd.get();
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mStopFd, &ev) != 0) {
+            PLOG(ERROR) << __func__ << ":Failed to watch stop event for " << name;
+            mStopFd.reset();
+            mEpollFd.reset();
+        } else if (!watch(true)) {
+            LOG(WARNING) << __func__ << ": " << name << " falls back to sampling";
+        }
+    }
+
+    sample();
+    if (mEpollFd < 0) {
+        // Nothing to wake the reader thread up with, queries are served from the first sample.
+        LOG(ERROR) << __func__ << ": " << name << " is not refreshed";
+        return;
+    }
+    mThread = std::thread([this, name] {
+        // Thread names are limited to 15 characters.
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+        readerLoop();
+    });
+}
+
+EventDrivenStateResidencyDataProvider::~EventDrivenStateResidencyDataProvider() {
+    if (mThread.joinable()) {
+        const uint64_t stop = 1;
+        TEMP_FAILURE_RETRY(write(mStopFd, &stop, sizeof(stop)));
+        mThread.join();
+    }
+}
+
+bool EventDrivenStateResidencyDataProvider::watch(bool logErrors) {
+    mWatchFd.reset(TEMP_FAILURE_RETRY(open(kWatchPath.c_str(), O_RDONLY | O_CLOEXEC)));
+    if (mWatchFd < 0) {
+        if (logErrors) {
+            PLOG(ERROR) << __func__ << ":Failed to open file " << kWatchPath;
+        }
+        return false;
+    }
+    // sysfs_notify() raises EPOLLPRI | EPOLLERR once the node has been read.
+    if (!rearm()) {
+        mWatchFd.reset();
+        return false;
+    }
+    epoll_event ev = {};
+    ev.events = EPOLLPRI;
+    ev.data.fd = mWatchFd.get();
+    if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWatchFd, &ev) != 0) {
+        // The node exists but cannot be polled, there is no point in reopening it.
+        PLOG(ERROR) << __func__ << ":Failed to watch file " << kWatchPath;
+        mWatchFd.reset();
+        mPollable = false;
+        return false;
+    }
+    return true;
+}
+
+void EventDrivenStateResidencyDataProvider::unwatch() {
+    epoll_ctl(mEpollFd, EPOLL_CTL_DEL, mWatchFd, nullptr);
+    mWatchFd.reset();
+}
+
+bool EventDrivenStateResidencyDataProvider::rearm() {
+    // Reading from offset 0 acknowledges the notification, the contents are read by the provider.
+    // It fails with ENODEV once the node has been removed.
+    char buf[64];
+    if (TEMP_FAILURE_RETRY(pread(mWatchFd, buf, sizeof(buf), 0)) < 0) {
+        PLOG(ERROR) << __func__ << ":Failed to read file " << kWatchPath;
+        return false;
+    }
+    return true;
+}
+
+std::chrono::milliseconds EventDrivenStateResidencyDataProvider::getMinInterval() {
+    std::lock_guard<std::mutex> lock(mLock);
+    if (mQueryInterval.count() == 0) {
+        return kMaxInterval;
+    }
+    return std::clamp(mQueryInterval / 2, kMinInterval, kMaxInterval);
+}
+
+bool EventDrivenStateResidencyDataProvider::sample() {
+    std::unordered_map<std::string, std::vector<StateResidency>> sample;
+    bool status;
+    {
+        ScopedProviderCall call(mCounters);
+        status = mProvider->getStateResidencies(&sample);
+        if (!status) {
+            call.setFailed();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mLock);
+    const bool changed = status != mSampleStatus || sample != mSample;
+    // Keep serving the previous sample if a read fails after a successful one.
+    if (status || !mSampleStatus) {
+        mSample = std::move(sample);
+        mSampleStatus = status;
+    }
+    return changed;
+}
+
+void EventDrivenStateResidencyDataProvider::readerLoop() {
+    std::chrono::milliseconds interval = kMaxInterval;
+    int changedSamples = 0;
+    bool notified = false;
+    while (true) {
+        const std::chrono::milliseconds timeout = notified ? kMaxInterval : interval;
+        epoll_event events[2];
+        const int n = TEMP_FAILURE_RETRY(epoll_wait(mEpollFd, events, 2, timeout.count()));
+        if (n < 0) {
+            PLOG(ERROR) << __func__ << ":Failed to wait for events";
+            std::this_thread::sleep_for(timeout);
+        }
+
+        bool signalled = false;
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.fd == mStopFd.get()) {
+                return;
+            }
+            signalled = true;
+        }
+
+        if (mWatchFd >= 0) {
+            // Acknowledges a notification, and otherwise checks the node is still there.
+            if (rearm()) {
+                notified |= signalled;
+            } else {
+                LOG(WARNING) << __func__ << ": " << kName << " lost " << kWatchPath
+                             << ", falls back to sampling";
+                unwatch();
+                notified = false;
+            }
+        } else if (mPollable && watch(false)) {
+            LOG(INFO) << __func__ << ": " << kName << " watches " << kWatchPath << " again";
+        }
+
+        const bool changed = sample();
+        if (!notified) {
+            changedSamples = changed ? changedSamples + 1 : 0;
+            const std::chrono::milliseconds minInterval = getMinInterval();
+            interval = changed && changedSamples <= kMaxChangedSamples ? interval / 2
+                                                                       : interval * 2;
+            interval = std::clamp(interval, minInterval, kMaxInterval);
+        }
+    }
+}
+
+bool EventDrivenStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mLock);
+    if (mLastQuery.time_since_epoch().count() != 0) {
+        // At least 1 ms, 0 means no interval is known yet.
+        const auto sinceLast = std::max(
+                std::chrono::milliseconds(1),
+                std::chrono::duration_cast<std::chrono::milliseconds>(now - mLastQuery));
+        // Moving average, so that a burst of queries does not pin the interval down.
+        mQueryInterval = mQueryInterval.count() == 0 ? sinceLast
+                                                     : (3 * mQueryInterval + sinceLast) / 4;
+    }
+    mLastQuery = now;
+    residencies->insert(mSample.begin(), mSample.end());
+    return mSampleStatus;
+}
+
+std::unordered_map<std::string, std::vector<State>>
+EventDrivenStateResidencyDataProvider::getInfo() {
+    return mProvider->getInfo();
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
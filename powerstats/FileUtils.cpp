@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FileUtils.h"
+
+#include "ProviderTelemetry.h"
+
+#include <android-base/logging.h>
+#include <android-base/unique_fd.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+using ::android::base::unique_fd;
+
+// Size of the first allocation for an empty buffer.
+static constexpr size_t kMinBufferSize = 4096;
+
+static std::mutex sPathLock;
+static std::string sPathRoot;
+static std::set<std::string> sRemappedPaths;
+
+// Reads from fd until EOF, from offset 0 if seekable or from the current offset otherwise. Returns
+// 0 on success or the errno of the failed read, EFBIG past kMaxFileSize bytes.
+static int readFdToBuffer(int fd, bool seekable, std::vector<char> *buffer, size_t *used) {
+    const size_t start = *used;
+    while (true) {
+        if (*used - start > kMaxFileSize) {
+            *used = start;
+            return EFBIG;
+        }
+        if (*used == buffer->size()) {
+            // One byte past the limit is enough to tell the file is too large.
+            buffer->resize(std::min(std::max(kMinBufferSize, 2 * buffer->size()),
+                                    start + kMaxFileSize + 1));
+        }
+
+        const size_t size = buffer->size() - *used;
+        ssize_t n = seekable ? TEMP_FAILURE_RETRY(pread(fd, buffer->data() + *used, size,
+                                                        *used - start))
+                             : TEMP_FAILURE_RETRY(read(fd, buffer->data() + *used, size));
+        if (n < 0) {
+            const int err = errno;
+            *used = start;
+            return err;
+        }
+        if (n == 0) {
+            countBytesRead(*used - start);
+            return 0;
+        }
+        *used += n;
+    }
+}
+
+bool readFileToBuffer(const std::string &path, std::vector<char> *buffer, size_t *used) {
+    unique_fd fd(TEMP_FAILURE_RETRY(open(path.c_str(), O_RDONLY | O_CLOEXEC)));
+    if (fd < 0) {
+        PLOG(ERROR) << __func__ << ":Failed to open file " << path;
+        countReadError();
+        return false;
+    }
+
+    if (int err = readFdToBuffer(fd, false, buffer, used); err != 0) {
+        errno = err;
+        PLOG(ERROR) << __func__ << ":Failed to read file " << path;
+        countReadError();
+        return false;
+    }
+    return true;
+}
+
+bool CachedFile::open() {
+    mFd.reset(TEMP_FAILURE_RETRY(::open(mPath.c_str(), O_RDONLY | O_CLOEXEC)));
+    if (mFd < 0) {
+        PLOG(ERROR) << __func__ << ":Failed to open file " << mPath;
+        countReadError();
+        return false;
+    }
+    return true;
+}
+
+bool CachedFile::read(std::vector<char> *buffer, size_t *used) {
+    const bool reused = mFd >= 0 && mSeekable;
+    if (!reused && !open()) {
+        return false;
+    }
+
+    int err = readFdToBuffer(mFd, mSeekable, buffer, used);
+    if (err == ESPIPE) {
+        // Character devices such as /dev/bbd_pwrstat do not support pread.
+        mSeekable = false;
+        if (!open()) {
+            return false;
+        }
+        err = readFdToBuffer(mFd, false, buffer, used);
+    } else if (err != 0 && err != EFBIG && reused) {
+        // The node may have been removed and recreated, e.g. by a driver restart.
+        if (!open()) {
+            return false;
+        }
+        err = readFdToBuffer(mFd, true, buffer, used);
+    }
+
+    if (err != 0) {
+        errno = err;
+        PLOG(ERROR) << __func__ << ":Failed to read file " << mPath;
+        countReadError();
+        mFd.reset();
+        return false;
+    }
+    return true;
+}
+
+void setPathRoot(const std::string &root) {
+    std::lock_guard<std::mutex> lock(sPathLock);
+    sPathRoot = root;
+    // Paths are joined as root + path, and path is absolute.
+    while (!sPathRoot.empty() && sPathRoot.back() == '/') {
+        sPathRoot.pop_back();
+    }
+}
+
+std::string remapPath(const std::string &path) {
+    std::lock_guard<std::mutex> lock(sPathLock);
+    sRemappedPaths.insert(path);
+    return sPathRoot + path;
+}
+
+std::vector<std::string> getRemappedPaths() {
+    std::lock_guard<std::mutex> lock(sPathLock);
+    return {sRemappedPaths.begin(), sRemappedPaths.end()};
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
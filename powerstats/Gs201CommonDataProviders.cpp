@@ -16,12 +16,27 @@
 
 #include <PowerStatsAidl.h>
 #include <Gs201CommonDataProviders.h>
-#include <AdaptiveDvfsStateResidencyDataProvider.h>
+#include <AcpmDvfsStateResidencyDataProvider.h>
+#include <AcpmStateResidencyDataProvider.h>
+#include <AcpmStatsSnapshot.h>
+#include <AdaptiveTimeoutStateResidencyDataProvider.h>
 #include <AocTimedStateResidencyDataProvider.h>
+#include <AsyncStateResidencyDataProvider.h>
+#include <BufferedStateResidencyDataProvider.h>
+#include <CoalescedEnergyMeterDataProvider.h>
+#include <CpuTopology.h>
 #include <DevfreqStateResidencyDataProvider.h>
-#include <DvfsStateResidencyDataProvider.h>
+#include <EventDrivenStateResidencyDataProvider.h>
+#include <FileUtils.h>
+#include <Gs201PowerEntityTables.h>
+#include <IncrementalAttributionEnergyConsumer.h>
+#include <InstrumentedStateResidencyDataProvider.h>
+#include <LazyStateResidencyDataProvider.h>
+#include <ParallelStateResidencyDataProvider.h>
+#include <PowerStatsDumpServer.h>
+#include <PushStateResidencyDataProvider.h>
+#include <RailSampler.h>
 #include <UfsStateResidencyDataProvider.h>
-#include <dataproviders/GenericStateResidencyDataProvider.h>
 #include <dataproviders/IioEnergyMeterDataProvider.h>
 #include <dataproviders/PowerStatsEnergyConsumer.h>
 #include <dataproviders/PowerStatsEnergyAttribution.h>
@@ -30,41 +45,188 @@
 
 #include <android-base/logging.h>
 #include <android-base/properties.h>
+#include <android-base/strings.h>
 #include <android/binder_manager.h>
 #include <android/binder_process.h>
 #include <log/log.h>
 
-using aidl::android::hardware::power::stats::AdaptiveDvfsStateResidencyDataProvider;
+#include <algorithm>
+
+using aidl::android::hardware::power::stats::AcpmDvfsStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::AcpmStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::AcpmStatsSnapshot;
+using aidl::android::hardware::power::stats::AdaptiveTimeoutStateResidencyDataProvider;
 using aidl::android::hardware::power::stats::AocTimedStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::AsyncStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::AttributedConsumerTable;
+using aidl::android::hardware::power::stats::BufferedStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::CoalescedEnergyMeterDataProvider;
+using aidl::android::hardware::power::stats::containsWord;
+using aidl::android::hardware::power::stats::CpuTopology;
 using aidl::android::hardware::power::stats::DevfreqStateResidencyDataProvider;
-using aidl::android::hardware::power::stats::DvfsStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::EventDrivenStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::buildDvfsConfigs;
+using aidl::android::hardware::power::stats::buildPowerEntityConfigs;
+using aidl::android::hardware::power::stats::buildPowerEntityInfo;
+using aidl::android::hardware::power::stats::buildPrefixedPairs;
+using aidl::android::hardware::power::stats::buildStates;
+using aidl::android::hardware::power::stats::buildStateCoeffs;
+using aidl::android::hardware::power::stats::buildStrings;
+using aidl::android::hardware::power::stats::remapPath;
 using aidl::android::hardware::power::stats::UfsStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::UserspaceEntityTable;
 using aidl::android::hardware::power::stats::EnergyConsumerType;
-using aidl::android::hardware::power::stats::GenericStateResidencyDataProvider;
 using aidl::android::hardware::power::stats::IioEnergyMeterDataProvider;
+using aidl::android::hardware::power::stats::IncrementalAttributionEnergyConsumer;
+using aidl::android::hardware::power::stats::InstrumentedStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::LazyStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::ParallelStateResidencyDataProvider;
 using aidl::android::hardware::power::stats::PixelStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::PowerEntityTable;
+using aidl::android::hardware::power::stats::PowerStatsDumpServer;
 using aidl::android::hardware::power::stats::PowerStatsEnergyConsumer;
+using aidl::android::hardware::power::stats::PushStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::readFileToBuffer;
+using aidl::android::hardware::power::stats::RailSampler;
+using aidl::android::hardware::power::stats::State;
+using aidl::android::hardware::power::stats::StateTable;
+using aidl::android::hardware::power::stats::TableRef;
 using aidl::android::hardware::power::stats::WlanStateResidencyDataProvider;
 
+namespace gs201 = aidl::android::hardware::power::stats::gs201;
+
+// Number of threads reading the providers added by addGs201CommonDataProviders() concurrently.
+// Providers are read sequentially when unset or 0.
+static const char *const kFanOutThreadsProp = "persist.vendor.powerstats.fanout.threads";
+// Time a concurrent read waits for slow providers before using their last result.
+static const char *const kFanOutDeadlineProp = "persist.vendor.powerstats.fanout.deadline_ms";
+static const uint64_t kDefaultFanOutDeadlineMs = 200;
+
+// Reads AoC state residencies ahead of time instead of on the binder thread.
+static const char *const kAocAsyncProp = "persist.vendor.powerstats.aoc.async";
+// Period of AoC reads in the absence of queries in async mode. 0 only reads after queries.
+static const char *const kAocRefreshProp = "persist.vendor.powerstats.aoc.refresh_ms";
+// Age above which an AoC sample is not served in async mode: the query reads the AoC itself
+// instead. 0 serves samples of any age.
+static const char *const kAocMaxAgeProp = "persist.vendor.powerstats.aoc.max_age_ms";
+static const uint64_t kDefaultAocMaxAgeMs = 1000;
+// Bounds the wait on each AoC entity by the latency it is read with, instead of 120ms per state.
+static const char *const kAocAdaptiveTimeoutProp = "persist.vendor.powerstats.aoc.adaptive_timeout";
+static const std::chrono::milliseconds kAocMinTimeout(10);
+static const std::chrono::milliseconds kAocStateTimeout(120);
+// Frequency of the AoC timer the timed providers convert residencies from.
+static const char *const kAocClockProp = "persist.vendor.powerstats.aoc.clock";
+static const uint64_t kDefaultAocClock = 24576;
+
+// Creates the providers whose power entities are known ahead of time on their first query.
+static const char *const kLazyProp = "persist.vendor.powerstats.lazy";
+
+// Window within which all ODPM readers share one sample of every channel. 0 reads on every call.
+static const char *const kOdpmCoalesceProp = "persist.vendor.powerstats.odpm.coalesce_ms";
+
+// Keeps PCIe and WLAN link state residencies up to date in memory, refreshed on sysfs_notify().
+static const char *const kLinkEventDrivenProp = "persist.vendor.powerstats.link.event_driven";
+// Longest interval between samples of link state nodes that are not notified.
+static const char *const kLinkMaxIntervalProp = "persist.vendor.powerstats.link.max_interval_ms";
+static const uint64_t kDefaultLinkMaxIntervalMs = 10000;
+static const std::chrono::milliseconds kLinkMinInterval(100);
+
+// Attributes GPU and TPU energy to UIDs from the rows of uid_time_in_state that changed only.
+static const char *const kIncrementalAttributionProp =
+        "persist.vendor.powerstats.attribution.incremental";
+
+// ODPM channels sampled in the background, as "<channel>:<period ms>,...". Empty disables it.
+static const char *const kOdpmRailPeriodsProp = "persist.vendor.powerstats.odpm.rail_periods";
+
+// User space entities whose clients push their transitions, as "<entity>,...". See
+// PushStateResidencyDataProvider.
+static const char *const kPushEntitiesProp = "persist.vendor.powerstats.push.entities";
+
+// ODPM meter installed by setEnergyMeter(), shared with the consumers that need channel lookups.
+static CoalescedEnergyMeterDataProvider *sEnergyMeter = nullptr;
+
+// Sampler of the rails listed in kOdpmRailPeriodsProp, if any. Never destroyed, as its thread
+// reads the meter owned by the PowerStats instance.
+static RailSampler *sRailSampler = nullptr;
+
+// Serves the dump of the service's PowerStats instance to powerstats_dump.gs201. Never destroyed.
+static PowerStatsDumpServer *sDumpServer = nullptr;
+
+// Non-null while addGs201CommonDataProviders() groups its providers for concurrent reads.
+static ParallelStateResidencyDataProvider *sFanOut = nullptr;
+
+// Names a provider after its first power entity, e.g. "AoC+6" for AoC and six more.
+static std::string getProviderName(PowerStats::IStateResidencyDataProvider *sdp) {
+    std::string name;
+    const auto info = sdp->getInfo();
+    for (const auto &[entity, states] : info) {
+        if (name.empty() || entity < name) {
+            name = entity;
+        }
+    }
+    if (info.size() > 1) {
+        name += "+" + std::to_string(info.size() - 1);
+    }
+    return name;
+}
+
+static void addStateResidencyDataProvider(std::shared_ptr<PowerStats> p,
+        std::unique_ptr<PowerStats::IStateResidencyDataProvider> sdp) {
+    const std::string name = getProviderName(sdp.get());
+    sdp = std::make_unique<InstrumentedStateResidencyDataProvider>(name, std::move(sdp));
+    if (sFanOut) {
+        sdp = sFanOut->addDataProvider(std::move(sdp));
+    }
+    p->addStateResidencyDataProvider(std::move(sdp));
+}
+
+static bool isLazy() {
+    static const bool lazy = android::base::GetBoolProperty(kLazyProp, false);
+    return lazy;
+}
+
+static void addMeterAndAttrConsumer(std::shared_ptr<PowerStats> p,
+        const AttributedConsumerTable &consumer) {
+    const std::string name(consumer.name);
+    const std::vector<std::string> channels = buildStrings(consumer.channels);
+    const std::string uidTimeInStatePath = remapPath(std::string(consumer.uidTimeInStatePath));
+    const std::map<std::string, int32_t> stateCoeffs = buildStateCoeffs(consumer.stateCoeffs);
+    if (sEnergyMeter && android::base::GetBoolProperty(kIncrementalAttributionProp, false)) {
+        p->addEnergyConsumer(std::make_unique<IncrementalAttributionEnergyConsumer>(sEnergyMeter,
+                EnergyConsumerType::OTHER, name, channels, uidTimeInStatePath, stateCoeffs));
+    } else {
+        p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterAndAttrConsumer(p,
+                EnergyConsumerType::OTHER, name, channels,
+                {{UID_TIME_IN_STATE, uidTimeInStatePath}}, stateCoeffs));
+    }
+}
+
+// info must describe the power entities of the providers made by factory.
+static void addLazyStateResidencyDataProvider(std::shared_ptr<PowerStats> p,
+        std::unordered_map<std::string, std::vector<State>> info,
+        LazyStateResidencyDataProvider::Factory factory) {
+    if (isLazy()) {
+        addStateResidencyDataProvider(p, std::make_unique<LazyStateResidencyDataProvider>(
+                std::move(info), std::move(factory)));
+    } else {
+        addStateResidencyDataProvider(p, factory());
+    }
+}
+
 // TODO (b/181070764) (b/182941084):
 // Remove this when Wifi/BT energy consumption models are available or revert before ship
 using aidl::android::hardware::power::stats::EnergyConsumerResult;
 using aidl::android::hardware::power::stats::Channel;
 using aidl::android::hardware::power::stats::EnergyMeasurement;
+
+// The WiFi and BT consumers split the same rail and are read back to back, so they share a sample.
+static const std::chrono::milliseconds kPlaceholderMaxAge(50);
+
 class PlaceholderEnergyConsumer : public PowerStats::IEnergyConsumer {
   public:
-    PlaceholderEnergyConsumer(std::shared_ptr<PowerStats> p, EnergyConsumerType type,
-            std::string name) : kType(type), kName(name), mPowerStats(p), mChannelId(-1) {
-        std::vector<Channel> channels;
-        mPowerStats->getEnergyMeterInfo(&channels);
-
-        for (const auto &c : channels) {
-            if (c.name == "VSYS_PWR_WLAN_BT") {
-                mChannelId = c.id;
-                break;
-            }
-        }
-    }
+    PlaceholderEnergyConsumer(CoalescedEnergyMeterDataProvider *meter, EnergyConsumerType type,
+            std::string name) : kType(type), kName(name), mMeter(meter),
+            mChannelId(meter ? meter->getChannelId("VSYS_PWR_WLAN_BT") : -1) {}
     std::pair<EnergyConsumerType, std::string> getInfo() override { return {kType, kName}; }
 
     std::optional<EnergyConsumerResult> getEnergyConsumed() override {
@@ -72,11 +234,9 @@ class PlaceholderEnergyConsumer : public PowerStats::IEnergyConsumer {
         int64_t timestampMs = 0;
         if (mChannelId != -1) {
             std::vector<EnergyMeasurement> measurements;
-            if (mPowerStats->readEnergyMeter({mChannelId}, &measurements).isOk()) {
-                for (const auto &m : measurements) {
-                    totalEnergyUWs += m.energyUWs;
-                    timestampMs = m.timestampMs;
-                }
+            if (mMeter->readEnergyMeter({mChannelId}, &measurements, kPlaceholderMaxAge).isOk()) {
+                totalEnergyUWs = measurements.front().energyUWs;
+                timestampMs = measurements.front().timestampMs;
             } else {
                 LOG(ERROR) << "Failed to read energy meter";
                 return {};
@@ -94,281 +254,282 @@ class PlaceholderEnergyConsumer : public PowerStats::IEnergyConsumer {
   private:
     const EnergyConsumerType kType;
     const std::string kName;
-    std::shared_ptr<PowerStats> mPowerStats;
-    int32_t mChannelId;
+    // Owned by the PowerStats instance this consumer is added to.
+    CoalescedEnergyMeterDataProvider *const mMeter;
+    const int32_t mChannelId;
+};
+
+// The ACPM stats nodes stay open, and every provider registered on them rereads into one buffer.
+static std::shared_ptr<AcpmStatsSnapshot> getAcpmStatsSnapshot() {
+    static std::shared_ptr<AcpmStatsSnapshot> snapshot =
+            std::make_shared<AcpmStatsSnapshot>(remapPath("/sys/devices/platform/acpm_stats/"));
+    return snapshot;
+}
+
+/*
+ * CPU entities, cpufreq policies and ODPM rails of the clusters, built from the CpuTopology of the
+ * device. Falls back to the gs201 tables when it cannot be discovered. The entity tables point
+ * into the names owned here, so it is never freed.
+ */
+struct CpuEntities {
+    std::vector<std::string> names;
+    std::vector<PowerEntityTable> entities;
+    // (cluster name, cpufreq stats directory), not remapped.
+    std::vector<std::pair<std::string, std::string>> policies;
+    // (consumer name, rail suffix) of each cluster.
+    std::vector<std::pair<std::string, std::string>> rails;
 };
 
+static const CpuEntities &getCpuEntities() {
+    static const CpuEntities *sCpuEntities = [] {
+        CpuEntities *cpu = new CpuEntities();
+        CpuTopology topology;
+        if (!topology.discover()) {
+            LOG(WARNING) << "Falling back to the gs201 CPU layout";
+            cpu->entities.assign(std::begin(gs201::kCpuEntities), std::end(gs201::kCpuEntities));
+            for (const auto &policy : gs201::kCpufreqPolicies) {
+                cpu->policies.emplace_back(policy.name, policy.key);
+            }
+            for (size_t i = 0; i < cpu->policies.size(); i++) {
+                cpu->rails.emplace_back("CPUCL" + std::to_string(i),
+                        "_VDD_CPUCL" + std::to_string(i));
+            }
+            return cpu;
+        }
+
+        const std::vector<CpuTopology::Cluster> &clusters = topology.getClusters();
+        for (size_t i = 0; i < clusters.size(); i++) {
+            for (size_t core = 0; core < clusters[i].cpus.size(); core++) {
+                cpu->names.push_back(CpuTopology::getCoreName(i, core));
+            }
+        }
+        for (size_t i = 0; i < clusters.size(); i++) {
+            cpu->names.push_back(CpuTopology::getClusterName(i));
+            cpu->policies.emplace_back("CL" + std::to_string(i), clusters[i].policyDir + "/stats");
+            cpu->rails.emplace_back("CPUCL" + std::to_string(i), "_VDD_CPUCL" + std::to_string(i));
+        }
+
+        // Cores and clusters ACPM does not report would only fail every read of the provider.
+        std::vector<char> buffer;
+        size_t used = 0;
+        if (readFileToBuffer(getAcpmStatsSnapshot()->getPath(AcpmStatsSnapshot::CORE), &buffer,
+                             &used)) {
+            const std::string_view acpm(buffer.data(), used);
+            cpu->names.erase(std::remove_if(cpu->names.begin(), cpu->names.end(),
+                    [&acpm](const std::string &name) {
+                        if (containsWord(acpm, name)) {
+                            return false;
+                        }
+                        LOG(WARNING) << "ACPM does not report " << name;
+                        return true;
+                    }), cpu->names.end());
+        }
+        // names is final, the tables can point into it.
+        for (const std::string &name : cpu->names) {
+            cpu->entities.push_back({name, name, &gs201::kDownFields, gs201::kCpuStates});
+        }
+        return cpu;
+    }();
+    return *sCpuEntities;
+}
+
+static void addAcpmDataProvider(std::shared_ptr<PowerStats> p, AcpmStatsSnapshot::Node node,
+        TableRef<PowerEntityTable> entities) {
+    addLazyStateResidencyDataProvider(p, buildPowerEntityInfo(entities), [node, entities] {
+        return std::make_unique<AcpmStateResidencyDataProvider>(getAcpmStatsSnapshot(), node,
+                buildPowerEntityConfigs(entities));
+    });
+}
+
+static void addBufferedDataProvider(std::shared_ptr<PowerStats> p, const std::string &path,
+        TableRef<PowerEntityTable> entities) {
+    addLazyStateResidencyDataProvider(p, buildPowerEntityInfo(entities), [path, entities] {
+        return std::make_unique<BufferedStateResidencyDataProvider>(path,
+                buildPowerEntityConfigs(entities));
+    });
+}
+
+static bool isLinkEventDriven() {
+    static const bool eventDriven = android::base::GetBoolProperty(kLinkEventDrivenProp, false);
+    return eventDriven;
+}
+
+static std::unique_ptr<PowerStats::IStateResidencyDataProvider> makeEventDriven(
+        const std::string &name, std::unique_ptr<PowerStats::IStateResidencyDataProvider> sdp,
+        const std::string &path) {
+    const std::chrono::milliseconds maxInterval(android::base::GetUintProperty<uint64_t>(
+            kLinkMaxIntervalProp, kDefaultLinkMaxIntervalMs));
+    return std::make_unique<EventDrivenStateResidencyDataProvider>(name, std::move(sdp), path,
+            kLinkMinInterval, maxInterval);
+}
+
+static void addLinkStateDataProvider(std::shared_ptr<PowerStats> p, const std::string &name,
+        const std::string &path, TableRef<PowerEntityTable> entities) {
+    if (!isLinkEventDriven()) {
+        addBufferedDataProvider(p, path, entities);
+        return;
+    }
+    addLazyStateResidencyDataProvider(p, buildPowerEntityInfo(entities), [=] {
+        return makeEventDriven(name, std::make_unique<BufferedStateResidencyDataProvider>(path,
+                buildPowerEntityConfigs(entities)), path);
+    });
+}
+
 void addPlaceholderEnergyConsumers(std::shared_ptr<PowerStats> p) {
-    p->addEnergyConsumer(
-            std::make_unique<PlaceholderEnergyConsumer>(p, EnergyConsumerType::WIFI, "Wifi"));
-    p->addEnergyConsumer(
-            std::make_unique<PlaceholderEnergyConsumer>(p, EnergyConsumerType::BLUETOOTH, "BT"));
+    p->addEnergyConsumer(std::make_unique<PlaceholderEnergyConsumer>(
+            sEnergyMeter, EnergyConsumerType::WIFI, "Wifi"));
+    p->addEnergyConsumer(std::make_unique<PlaceholderEnergyConsumer>(
+            sEnergyMeter, EnergyConsumerType::BLUETOOTH, "BT"));
 }
 
 void addAoC(std::shared_ptr<PowerStats> p) {
     // When the given timeout is 0, the timeout will be replaced with "120ms * statesCount".
     static const uint64_t TIMEOUT_MILLIS = 0;
     // AoC clock is synced from "libaoc.c"
-    static const uint64_t AOC_CLOCK = 24576;
-    std::string prefix = "/sys/devices/platform/19000000.aoc/control/";
-
-    // Add AoC cores (a32, ff1, hf0, and hf1)
-    std::vector<std::pair<std::string, std::string>> coreIds = {
-            {"AoC-A32", prefix + "a32_"},
-            {"AoC-FF1", prefix + "ff1_"},
-            {"AoC-HF1", prefix + "hf1_"},
-            {"AoC-HF0", prefix + "hf0_"},
-    };
-    std::vector<std::pair<std::string, std::string>> coreStates = {
-            {"DWN", "off"}, {"RET", "retention"}, {"WFI", "wfi"}};
-    p->addStateResidencyDataProvider(std::make_unique<AocTimedStateResidencyDataProvider>(coreIds,
-            coreStates, TIMEOUT_MILLIS, AOC_CLOCK));
-
-    // Add AoC voltage stats
-    std::vector<std::pair<std::string, std::string>> voltageIds = {
-            {"AoC-Voltage", prefix + "voltage_"},
-    };
-    std::vector<std::pair<std::string, std::string>> voltageStates = {{"NOM", "nominal"},
-                                                                      {"SUD", "super_underdrive"},
-                                                                      {"UUD", "ultra_underdrive"},
-                                                                      {"UD", "underdrive"}};
-    p->addStateResidencyDataProvider(
-            std::make_unique<AocTimedStateResidencyDataProvider>(voltageIds, voltageStates,
-                    TIMEOUT_MILLIS, AOC_CLOCK));
-
-    // Add AoC monitor mode
-    std::vector<std::pair<std::string, std::string>> monitorIds = {
-            {"AoC", prefix + "monitor_"},
-    };
-    std::vector<std::pair<std::string, std::string>> monitorStates = {
-            {"MON", "mode"},
-    };
-    p->addStateResidencyDataProvider(
-            std::make_unique<AocTimedStateResidencyDataProvider>(monitorIds, monitorStates,
-                    TIMEOUT_MILLIS, AOC_CLOCK));
-
-    // Add AoC restart count
-    const GenericStateResidencyDataProvider::StateResidencyConfig restartCountConfig = {
-            .entryCountSupported = true,
-            .entryCountPrefix = "",
-            .totalTimeSupported = false,
-            .lastEntrySupported = false,
-    };
-    const std::vector<std::pair<std::string, std::string>> restartCountHeaders = {
-            std::make_pair("RESTART", ""),
+    const uint64_t aocClock = android::base::GetUintProperty<uint64_t>(kAocClockProp,
+            kDefaultAocClock);
+    std::string prefix = remapPath("/sys/devices/platform/19000000.aoc/control/");
+
+    // In async mode each timed provider is read ahead of time on its own thread, so a busy AoC
+    // does not stall the queries that find a sample younger than maxAge.
+    const bool async = android::base::GetBoolProperty(kAocAsyncProp, false);
+    const std::chrono::milliseconds refreshInterval(
+            android::base::GetUintProperty<uint64_t>(kAocRefreshProp, 0));
+    const std::chrono::milliseconds maxAge(
+            android::base::GetUintProperty<uint64_t>(kAocMaxAgeProp, kDefaultAocMaxAgeMs));
+    // In adaptive mode every entity gets its own provider, whose timeout follows the latency
+    // that entity is read with. That only shortens queries made while the AoC does not answer;
+    // with fan-out, the split entities are also read concurrently.
+    const bool adaptive = android::base::GetBoolProperty(kAocAdaptiveTimeoutProp, false);
+
+    auto makeTimedProvider = [=](TableRef<StateTable> entities, TableRef<StateTable> states,
+            std::chrono::milliseconds timeout) {
+        return std::make_unique<AocTimedStateResidencyDataProvider>(
+                buildPrefixedPairs(entities, prefix), buildPrefixedPairs(states, ""),
+                timeout.count(), aocClock);
+    };
+    auto addAocProvider = [&](const std::string &name, TableRef<StateTable> entities,
+            TableRef<StateTable> states) {
+        // In lazy and async mode the reader thread is only started by the first query, which
+        // then waits for the first sample, or finds none yet if maxAge is 0.
+        addLazyStateResidencyDataProvider(p, buildPowerEntityInfo(entities, states),
+                [=]() -> std::unique_ptr<PowerStats::IStateResidencyDataProvider> {
+            std::unique_ptr<PowerStats::IStateResidencyDataProvider> sdp;
+            if (adaptive) {
+                sdp = std::make_unique<AdaptiveTimeoutStateResidencyDataProvider>(
+                        [=](std::chrono::milliseconds timeout) {
+                            return makeTimedProvider(entities, states, timeout);
+                        },
+                        kAocMinTimeout, kAocStateTimeout * states.size());
+            } else {
+                sdp = makeTimedProvider(entities, states,
+                        std::chrono::milliseconds(TIMEOUT_MILLIS));
+            }
+            if (async) {
+                sdp = std::make_unique<AsyncStateResidencyDataProvider>(name, std::move(sdp),
+                        refreshInterval, maxAge);
+            }
+            return sdp;
+        });
+    };
+    auto addAocProviders = [&](const std::string &name, TableRef<StateTable> entities,
+            TableRef<StateTable> states) {
+        if (!adaptive) {
+            addAocProvider(name, entities, states);
+            return;
+        }
+        for (size_t i = 0; i < entities.size(); i++) {
+            addAocProvider(name + std::to_string(i),
+                    TableRef<StateTable>(entities.begin() + i, 1), states);
+        }
     };
-    std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs;
-    cfgs.emplace_back(
-            generateGenericStateResidencyConfigs(restartCountConfig, restartCountHeaders),
-            "AoC-Count", "");
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/sys/devices/platform/19000000.aoc/restart_count", cfgs));
+
+    addAocProviders("aoc-cores", gs201::kAocCores, gs201::kAocCoreStates);
+    addAocProviders("aoc-voltage", gs201::kAocVoltage, gs201::kAocVoltageStates);
+    addAocProviders("aoc-monitor", gs201::kAocMonitor, gs201::kAocMonitorStates);
+
+    addBufferedDataProvider(p, remapPath("/sys/devices/platform/19000000.aoc/restart_count"),
+            gs201::kAocRestartEntities);
 }
 
 void addDvfsStats(std::shared_ptr<PowerStats> p) {
     // A constant to represent the number of nanoseconds in one millisecond
     const int NS_TO_MS = 1000000;
-    std::string path = "/sys/devices/platform/acpm_stats/fvp_stats";
-
-    std::vector<std::pair<std::string, std::string>> adpCfgs = {
-        std::make_pair("CL0", "/sys/devices/system/cpu/cpufreq/policy0/stats"),
-        std::make_pair("CL1", "/sys/devices/system/cpu/cpufreq/policy4/stats"),
-        std::make_pair("CL2", "/sys/devices/system/cpu/cpufreq/policy6/stats")
-    };
-    p->addStateResidencyDataProvider(std::make_unique<AdaptiveDvfsStateResidencyDataProvider>(
-            path, NS_TO_MS, adpCfgs));
-
-    std::vector<DvfsStateResidencyDataProvider::Config> cfgs;
 
-    cfgs.push_back({"TPU", {
-        std::make_pair("1066MHz", "1066000"),
-        std::make_pair("845MHz", "845000"),
-        std::make_pair("627MHz", "627000"),
-        std::make_pair("401MHz", "401000"),
-        std::make_pair("226MHz", "226000"),
-        std::make_pair("0MHz", "0"),
-    }});
-
-    cfgs.push_back({"AUR", {
-        std::make_pair("1160MHz", "1160000"),
-        std::make_pair("750MHz", "750000"),
-        std::make_pair("373MHz", "373000"),
-        std::make_pair("178MHz", "178000"),
-        std::make_pair("0MHz", "0"),
-    }});
+    std::vector<std::pair<std::string, std::string>> adpCfgs;
+    for (const auto &[name, path] : getCpuEntities().policies) {
+        adpCfgs.emplace_back(name, remapPath(path));
+    }
+    // CPU clusters, TPU and AUR all live in fvp_stats, so a single provider parses them together.
+    std::vector<AcpmDvfsStateResidencyDataProvider::Config> cfgs =
+            AcpmDvfsStateResidencyDataProvider::cpufreqConfigs(adpCfgs);
+    for (auto &cfg : buildDvfsConfigs(gs201::kDvfsEntities)) {
+        cfgs.push_back(std::move(cfg));
+    }
 
-    p->addStateResidencyDataProvider(std::make_unique<DvfsStateResidencyDataProvider>(
-            path, NS_TO_MS, cfgs));
+    addStateResidencyDataProvider(p, std::make_unique<AcpmDvfsStateResidencyDataProvider>(
+            getAcpmStatsSnapshot(), NS_TO_MS, cfgs));
 }
 
 void addSoC(std::shared_ptr<PowerStats> p) {
-    // A constant to represent the number of nanoseconds in one millisecond.
-    const int NS_TO_MS = 1000000;
-
-    // ACPM stats are reported in nanoseconds. The transform function
-    // converts nanoseconds to milliseconds.
-    std::function<uint64_t(uint64_t)> acpmNsToMs = [](uint64_t a) { return a / NS_TO_MS; };
-    const GenericStateResidencyDataProvider::StateResidencyConfig lpmStateConfig = {
-            .entryCountSupported = true,
-            .entryCountPrefix = "success_count:",
-            .totalTimeSupported = true,
-            .totalTimePrefix = "total_time_ns:",
-            .totalTimeTransform = acpmNsToMs,
-            .lastEntrySupported = true,
-            .lastEntryPrefix = "last_entry_time_ns:",
-            .lastEntryTransform = acpmNsToMs,
-    };
-    const GenericStateResidencyDataProvider::StateResidencyConfig downStateConfig = {
-            .entryCountSupported = true,
-            .entryCountPrefix = "down_count:",
-            .totalTimeSupported = true,
-            .totalTimePrefix = "total_down_time_ns:",
-            .totalTimeTransform = acpmNsToMs,
-            .lastEntrySupported = true,
-            .lastEntryPrefix = "last_down_time_ns:",
-            .lastEntryTransform = acpmNsToMs,
-    };
-    const GenericStateResidencyDataProvider::StateResidencyConfig reqStateConfig = {
-            .entryCountSupported = true,
-            .entryCountPrefix = "req_up_count:",
-            .totalTimeSupported = true,
-            .totalTimePrefix = "total_req_up_time_ns:",
-            .totalTimeTransform = acpmNsToMs,
-            .lastEntrySupported = true,
-            .lastEntryPrefix = "last_req_up_time_ns:",
-            .lastEntryTransform = acpmNsToMs,
-
-    };
-    const std::vector<std::pair<std::string, std::string>> powerStateHeaders = {
-            std::make_pair("SICD", "SICD"),
-            std::make_pair("SLEEP", "SLEEP"),
-            std::make_pair("SLEEP_SLCMON", "SLEEP_SLCMON"),
-            std::make_pair("SLEEP_HSI1ON", "SLEEP_HSI1ON"),
-            std::make_pair("STOP", "STOP"),
-    };
-    const std::vector<std::pair<std::string, std::string>> mifReqStateHeaders = {
-            std::make_pair("AOC", "AOC"),
-            std::make_pair("GSA", "GSA"),
-            std::make_pair("TPU", "TPU"),
-    };
-    const std::vector<std::pair<std::string, std::string>> slcReqStateHeaders = {
-            std::make_pair("AOC", "AOC"),
-    };
-
-    std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs;
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(lpmStateConfig, powerStateHeaders),
-            "LPM", "LPM:");
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(downStateConfig, powerStateHeaders),
-            "MIF", "MIF:");
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(reqStateConfig, mifReqStateHeaders),
-            "MIF-REQ", "MIF_REQ:");
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(downStateConfig, powerStateHeaders),
-            "SLC", "SLC:");
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(reqStateConfig, slcReqStateHeaders),
-            "SLC-REQ", "SLC_REQ:");
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/sys/devices/platform/acpm_stats/soc_stats", cfgs));
+    addAcpmDataProvider(p, AcpmStatsSnapshot::SOC, gs201::kSocEntities);
 }
 
 void setEnergyMeter(std::shared_ptr<PowerStats> p) {
     std::vector<const std::string> deviceNames { "s2mpg12-odpm", "s2mpg13-odpm" };
-    p->setEnergyMeterDataProvider(std::make_unique<IioEnergyMeterDataProvider>(deviceNames, true));
+    auto meter = std::make_unique<CoalescedEnergyMeterDataProvider>(
+            std::make_unique<IioEnergyMeterDataProvider>(deviceNames, true),
+            std::chrono::milliseconds(
+                    android::base::GetUintProperty<uint64_t>(kOdpmCoalesceProp, 0)));
+    sEnergyMeter = meter.get();
+    p->setEnergyMeterDataProvider(std::move(meter));
+
+    std::vector<RailSampler::RailConfig> rails;
+    const std::string railPeriods = android::base::GetProperty(kOdpmRailPeriodsProp, "");
+    if (!RailSampler::parseRailConfigs(railPeriods, &rails)) {
+        LOG(ERROR) << "Invalid " << kOdpmRailPeriodsProp << ": " << railPeriods;
+    } else if (!rails.empty() && !sRailSampler) {
+        sRailSampler = new RailSampler(sEnergyMeter, rails);
+    }
 }
 
-void addCPUclusters(std::shared_ptr<PowerStats> p) {
-    // A constant to represent the number of nanoseconds in one millisecond.
-    const int NS_TO_MS = 1000000;
-
-    std::function<uint64_t(uint64_t)> acpmNsToMs = [](uint64_t a) { return a / NS_TO_MS; };
-    const GenericStateResidencyDataProvider::StateResidencyConfig cpuStateConfig = {
-            .entryCountSupported = true,
-            .entryCountPrefix = "down_count:",
-            .totalTimeSupported = true,
-            .totalTimePrefix = "total_down_time_ns:",
-            .totalTimeTransform = acpmNsToMs,
-            .lastEntrySupported = true,
-            .lastEntryPrefix = "last_down_time_ns:",
-            .lastEntryTransform = acpmNsToMs,
-    };
-
-    const std::vector<std::pair<std::string, std::string>> cpuStateHeaders = {
-            std::make_pair("DOWN", ""),
-    };
+RailSampler *getRailSampler() {
+    return sRailSampler;
+}
 
-    std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs;
-    for (std::string name : {"CORE00", "CORE01", "CORE02", "CORE03", "CORE10", "CORE11",
-                                "CORE20", "CORE21", "CLUSTER0", "CLUSTER1", "CLUSTER2"}) {
-        cfgs.emplace_back(generateGenericStateResidencyConfigs(cpuStateConfig, cpuStateHeaders),
-            name, name);
+void addCPUclusters(std::shared_ptr<PowerStats> p) {
+    const CpuEntities &cpu = getCpuEntities();
+    addAcpmDataProvider(p, AcpmStatsSnapshot::CORE,
+            TableRef<PowerEntityTable>(cpu.entities.data(), cpu.entities.size()));
+
+    // The regulator supplying a cluster is not the same on every board, so rails match by suffix.
+    std::vector<Channel> channels;
+    p->getEnergyMeterInfo(&channels);
+    for (const auto &[name, suffix] : cpu.rails) {
+        auto channel = std::find_if(channels.begin(), channels.end(), [&](const Channel &c) {
+            return android::base::EndsWith(c.name, suffix);
+        });
+        if (channel == channels.end()) {
+            LOG(WARNING) << "No rail for " << name;
+            continue;
+        }
+        p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterConsumer(p,
+                EnergyConsumerType::CPU_CLUSTER, name, {channel->name}));
     }
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/sys/devices/platform/acpm_stats/core_stats", cfgs));
-
-    p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterConsumer(p,
-            EnergyConsumerType::CPU_CLUSTER, "CPUCL0", {"S4M_VDD_CPUCL0"}));
-    p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterConsumer(p,
-            EnergyConsumerType::CPU_CLUSTER, "CPUCL1", {"S3M_VDD_CPUCL1"}));
-    p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterConsumer(p,
-            EnergyConsumerType::CPU_CLUSTER, "CPUCL2", {"S2M_VDD_CPUCL2"}));
 }
 
 void addGPU(std::shared_ptr<PowerStats> p) {
     // Add gpu energy consumer
-    std::map<std::string, int32_t> stateCoeffs;
-
-    // TODO (b/197721618): Measuring the GPU power numbers
-    stateCoeffs = {
-        {"202000",  890},
-        {"251000", 1102},
-        {"302000", 1308},
-        {"351000", 1522},
-        {"400000", 1772},
-        {"471000", 2105},
-        {"510000", 2292},
-        {"572000", 2528},
-        {"701000", 3127},
-        {"762000", 3452},
-        {"848000", 4044}};
-
-    p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterAndAttrConsumer(p,
-            EnergyConsumerType::OTHER, "GPU", {"S8S_VDD_G3D_L2", "S2S_VDD_G3D"},
-            {{UID_TIME_IN_STATE, "/sys/devices/platform/28000000.mali/uid_time_in_state"}},
-            stateCoeffs));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>("GPU",
-            "/sys/devices/platform/28000000.mali"));
+    addMeterAndAttrConsumer(p, gs201::kGpuConsumer);
+
+    addStateResidencyDataProvider(p, std::make_unique<DevfreqStateResidencyDataProvider>("GPU",
+            remapPath("/sys/devices/platform/28000000.mali")));
 }
 
 void addMobileRadio(std::shared_ptr<PowerStats> p)
 {
-    // A constant to represent the number of microseconds in one millisecond.
-    const int US_TO_MS = 1000;
-
-    // modem power_stats are reported in microseconds. The transform function
-    // converts microseconds to milliseconds.
-    std::function<uint64_t(uint64_t)> modemUsToMs = [](uint64_t a) { return a / US_TO_MS; };
-    const GenericStateResidencyDataProvider::StateResidencyConfig powerStateConfig = {
-            .entryCountSupported = true,
-            .entryCountPrefix = "count:",
-            .totalTimeSupported = true,
-            .totalTimePrefix = "duration_usec:",
-            .totalTimeTransform = modemUsToMs,
-            .lastEntrySupported = true,
-            .lastEntryPrefix = "last_entry_timestamp_usec:",
-            .lastEntryTransform = modemUsToMs,
-    };
-    const std::vector<std::pair<std::string, std::string>> powerStateHeaders = {
-            std::make_pair("SLEEP", "SLEEP:"),
-    };
-
-    std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs;
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(powerStateConfig, powerStateHeaders),
-            "MODEM", "");
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/sys/devices/platform/cpif/modem/power_stats", cfgs));
+    addBufferedDataProvider(p, remapPath("/sys/devices/platform/cpif/modem/power_stats"),
+            gs201::kModemEntities);
 
     p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterConsumer(p,
             EnergyConsumerType::MOBILE_RADIO, "MODEM",
@@ -377,35 +538,7 @@ void addMobileRadio(std::shared_ptr<PowerStats> p)
 
 void addGNSS(std::shared_ptr<PowerStats> p)
 {
-    // A constant to represent the number of microseconds in one millisecond.
-    const int US_TO_MS = 1000;
-
-    // gnss power_stats are reported in microseconds. The transform function
-    // converts microseconds to milliseconds.
-    std::function<uint64_t(uint64_t)> gnssUsToMs = [](uint64_t a) { return a / US_TO_MS; };
-
-    const GenericStateResidencyDataProvider::StateResidencyConfig gnssStateConfig = {
-        .entryCountSupported = true,
-        .entryCountPrefix = "count:",
-        .totalTimeSupported = true,
-        .totalTimePrefix = "duration_usec:",
-        .totalTimeTransform = gnssUsToMs,
-        .lastEntrySupported = true,
-        .lastEntryPrefix = "last_entry_timestamp_usec:",
-        .lastEntryTransform = gnssUsToMs,
-    };
-
-    const std::vector<std::pair<std::string, std::string>> gnssStateHeaders = {
-        std::make_pair("ON", "GPS_ON:"),
-        std::make_pair("OFF", "GPS_OFF:"),
-    };
-
-    std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs;
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(gnssStateConfig, gnssStateHeaders),
-            "GPS", "");
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/dev/bbd_pwrstat", cfgs));
+    addBufferedDataProvider(p, remapPath("/dev/bbd_pwrstat"), gs201::kGnssEntities);
 
     p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterConsumer(p,
             EnergyConsumerType::GNSS, "GPS", {"L9S_GNSS_CORE"}));
@@ -413,174 +546,46 @@ void addGNSS(std::shared_ptr<PowerStats> p)
 
 void addPCIe(std::shared_ptr<PowerStats> p) {
     // Add PCIe power entities for Modem and WiFi
-    const GenericStateResidencyDataProvider::StateResidencyConfig pcieStateConfig = {
-        .entryCountSupported = true,
-        .entryCountPrefix = "Cumulative count:",
-        .totalTimeSupported = true,
-        .totalTimePrefix = "Cumulative duration msec:",
-        .lastEntrySupported = true,
-        .lastEntryPrefix = "Last entry timestamp msec:",
-    };
-    const std::vector<std::pair<std::string, std::string>> pcieStateHeaders = {
-        std::make_pair("UP", "Link up:"),
-        std::make_pair("DOWN", "Link down:"),
-    };
-
-    // Add PCIe - Modem
-    const std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> pcieModemCfgs = {
-        {generateGenericStateResidencyConfigs(pcieStateConfig, pcieStateHeaders), "PCIe-Modem",
-                "Version: 1"}
-    };
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/sys/devices/platform/11920000.pcie/power_stats", pcieModemCfgs));
-
-    // Add PCIe - WiFi
-    const std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> pcieWifiCfgs = {
-        {generateGenericStateResidencyConfigs(pcieStateConfig, pcieStateHeaders),
-            "PCIe-WiFi", "Version: 1"}
-    };
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/sys/devices/platform/14520000.pcie/power_stats", pcieWifiCfgs));
+    addLinkStateDataProvider(p, "pcie-modem",
+            remapPath("/sys/devices/platform/11920000.pcie/power_stats"),
+            gs201::kPcieModemEntities);
+    addLinkStateDataProvider(p, "pcie-wifi",
+            remapPath("/sys/devices/platform/14520000.pcie/power_stats"),
+            gs201::kPcieWifiEntities);
 }
 
 void addWifi(std::shared_ptr<PowerStats> p) {
-    // The transform function converts microseconds to milliseconds.
-    std::function<uint64_t(uint64_t)> usecToMs = [](uint64_t a) { return a / 1000; };
-    const GenericStateResidencyDataProvider::StateResidencyConfig stateConfig = {
-        .entryCountSupported = true,
-        .entryCountPrefix = "count:",
-        .totalTimeSupported = true,
-        .totalTimePrefix = "duration_usec:",
-        .totalTimeTransform = usecToMs,
-        .lastEntrySupported = true,
-        .lastEntryPrefix = "last_entry_timestamp_usec:",
-        .lastEntryTransform = usecToMs,
-    };
-    const GenericStateResidencyDataProvider::StateResidencyConfig pcieStateConfig = {
-        .entryCountSupported = true,
-        .entryCountPrefix = "count:",
-        .totalTimeSupported = true,
-        .totalTimePrefix = "duration_usec:",
-        .totalTimeTransform = usecToMs,
-        .lastEntrySupported = false,
-    };
-
-    const std::vector<std::pair<std::string, std::string>> stateHeaders = {
-        std::make_pair("AWAKE", "AWAKE:"),
-        std::make_pair("ASLEEP", "ASLEEP:"),
-
-    };
-    const std::vector<std::pair<std::string, std::string>> pcieStateHeaders = {
-        std::make_pair("L0", "L0:"),
-        std::make_pair("L1", "L1:"),
-        std::make_pair("L1_1", "L1_1:"),
-        std::make_pair("L1_2", "L1_2:"),
-        std::make_pair("L2", "L2:"),
-    };
-
-    const std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs = {
-        {generateGenericStateResidencyConfigs(stateConfig, stateHeaders), "WIFI", "WIFI"},
-        {generateGenericStateResidencyConfigs(pcieStateConfig, pcieStateHeaders), "WIFI-PCIE",
-                "WIFI-PCIE"}
-    };
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>("/sys/wifi/power_stats",
-            cfgs));
+    addBufferedDataProvider(p, remapPath("/sys/wifi/power_stats"), gs201::kWifiEntities);
 }
 
 void addWlan(std::shared_ptr<PowerStats> p) {
-    p->addStateResidencyDataProvider(std::make_unique<WlanStateResidencyDataProvider>(
-            "WLAN",
-            "/sys/kernel/wifi/power_stats"));
+    const std::string path = remapPath("/sys/kernel/wifi/power_stats");
+    std::unique_ptr<PowerStats::IStateResidencyDataProvider> sdp =
+            std::make_unique<WlanStateResidencyDataProvider>("WLAN", path);
+    if (isLinkEventDriven()) {
+        sdp = makeEventDriven("wlan", std::move(sdp), path);
+    }
+    addStateResidencyDataProvider(p, std::move(sdp));
 }
 
 void addUfs(std::shared_ptr<PowerStats> p) {
-    p->addStateResidencyDataProvider(std::make_unique<UfsStateResidencyDataProvider>("/sys/bus/platform/devices/14700000.ufs/ufs_stats/"));
+    addStateResidencyDataProvider(p, std::make_unique<UfsStateResidencyDataProvider>(
+            remapPath("/sys/bus/platform/devices/14700000.ufs/ufs_stats/")));
 }
 
 void addPowerDomains(std::shared_ptr<PowerStats> p) {
-    // A constant to represent the number of nanoseconds in one millisecond.
-    const int NS_TO_MS = 1000000;
-
-    std::function<uint64_t(uint64_t)> acpmNsToMs = [](uint64_t a) { return a / NS_TO_MS; };
-    const GenericStateResidencyDataProvider::StateResidencyConfig cpuStateConfig = {
-            .entryCountSupported = true,
-            .entryCountPrefix = "on_count:",
-            .totalTimeSupported = true,
-            .totalTimePrefix = "total_on_time_ns:",
-            .totalTimeTransform = acpmNsToMs,
-            .lastEntrySupported = true,
-            .lastEntryPrefix = "last_on_time_ns:",
-            .lastEntryTransform = acpmNsToMs,
-    };
-
-    const std::vector<std::pair<std::string, std::string>> cpuStateHeaders = {
-            std::make_pair("ON", ""),
-    };
-
-    std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs;
-    for (std::string name : {"pd-aur", "pd-tpu", "pd-bo", "pd-tnr", "pd-gdc", "pd-mcsc", "pd-itp",
-                                "pd-ipp", "pd-g3aa", "pd-dns", "pd-pdp", "pd-csis",
-                                "pd-mfc", "pd-g2d", "pd-disp", "pd-dpu", "pd-hsi0",
-                                "pd-g3d", "pd-embedded_g3d", "pd-eh"}) {
-        cfgs.emplace_back(generateGenericStateResidencyConfigs(cpuStateConfig, cpuStateHeaders),
-            name, name + ":");
-    }
-
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            "/sys/devices/platform/acpm_stats/pd_stats", cfgs));
+    addAcpmDataProvider(p, AcpmStatsSnapshot::PD, gs201::kPowerDomainEntities);
 }
 
 void addDevfreq(std::shared_ptr<PowerStats> p) {
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "MIF",
-            "/sys/devices/platform/17000010.devfreq_mif/devfreq/17000010.devfreq_mif"));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "INT",
-            "/sys/devices/platform/17000020.devfreq_int/devfreq/17000020.devfreq_int"));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "INTCAM",
-            "/sys/devices/platform/17000030.devfreq_intcam/devfreq/17000030.devfreq_intcam"));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "DISP",
-            "/sys/devices/platform/17000040.devfreq_disp/devfreq/17000040.devfreq_disp"));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "CAM",
-            "/sys/devices/platform/17000050.devfreq_cam/devfreq/17000050.devfreq_cam"));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "TNR",
-            "/sys/devices/platform/17000060.devfreq_tnr/devfreq/17000060.devfreq_tnr"));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "MFC",
-            "/sys/devices/platform/17000070.devfreq_mfc/devfreq/17000070.devfreq_mfc"));
-
-    p->addStateResidencyDataProvider(std::make_unique<DevfreqStateResidencyDataProvider>(
-            "BO",
-            "/sys/devices/platform/17000080.devfreq_bo/devfreq/17000080.devfreq_bo"));
+    for (const auto &devfreq : gs201::kDevfreqEntities) {
+        addStateResidencyDataProvider(p, std::make_unique<DevfreqStateResidencyDataProvider>(
+                std::string(devfreq.name), remapPath(std::string(devfreq.key))));
+    }
 }
 
 void addTPU(std::shared_ptr<PowerStats> p) {
-    std::map<std::string, int32_t> stateCoeffs;
-
-    stateCoeffs = {
-        // TODO (b/197721618): Measuring the TPU power numbers
-        {"226000",  10},
-        {"627000",  20},
-        {"845000",  30},
-        {"1066000", 40}};
-
-    p->addEnergyConsumer(PowerStatsEnergyConsumer::createMeterAndAttrConsumer(p,
-            EnergyConsumerType::OTHER, "TPU", {"S10M_VDD_TPU"},
-            {{UID_TIME_IN_STATE, "/sys/class/edgetpu/edgetpu-soc/device/tpu_usage"}},
-            stateCoeffs));
+    addMeterAndAttrConsumer(p, gs201::kTpuConsumer);
 }
 
 /**
@@ -588,16 +593,39 @@ void addTPU(std::shared_ptr<PowerStats> p) {
  * this data provider acts as a general-purpose channel for state residency data providers
  * that live in user space. Entities are defined here and user space clients of this provider's
  * vendor service register callbacks to provide state residency data for their given pwoer entity.
+ * Entities listed in persist.vendor.powerstats.push.entities are served by a
+ * PushStateResidencyDataProvider instead, to which their clients stream state transitions.
  */
 void addPixelStateResidencyDataProvider(std::shared_ptr<PowerStats> p) {
+    const std::vector<std::string> pushed =
+            android::base::Split(android::base::GetProperty(kPushEntitiesProp, ""), ",");
+    auto isPushed = [&pushed](std::string_view name) {
+        return std::find(pushed.begin(), pushed.end(), name) != pushed.end();
+    };
 
     auto pixelSdp = std::make_unique<PixelStateResidencyDataProvider>();
+    auto pushSdp = std::make_unique<PushStateResidencyDataProvider>();
+    bool hasCallbackEntities = false;
+    bool hasPushEntities = false;
+    for (const UserspaceEntityTable &entity : gs201::kUserspaceEntities) {
+        if (isPushed(entity.name)) {
+            pushSdp->addEntity(std::string(entity.name), buildStates(entity.states),
+                               entity.clientUid);
+            hasPushEntities = true;
+        } else {
+            pixelSdp->addEntity(std::string(entity.name), buildStates(entity.states));
+            hasCallbackEntities = true;
+        }
+    }
 
-    pixelSdp->addEntity("Bluetooth", {{0, "Idle"}, {1, "Active"}, {2, "Tx"}, {3, "Rx"}});
-
-    pixelSdp->start();
-
-    p->addStateResidencyDataProvider(std::move(pixelSdp));
+    if (hasCallbackEntities) {
+        pixelSdp->start();
+        addStateResidencyDataProvider(p, std::move(pixelSdp));
+    }
+    if (hasPushEntities) {
+        pushSdp->start();
+        addStateResidencyDataProvider(p, std::move(pushSdp));
+    }
 }
 
 void addCamera(std::shared_ptr<PowerStats> p) {
@@ -608,10 +636,22 @@ void addCamera(std::shared_ptr<PowerStats> p) {
             {"VSYS_PWR_CAM"}));
 }
 
-void addGs201CommonDataProviders(std::shared_ptr<PowerStats> p) {
+static void addCommonDataProviders(std::shared_ptr<PowerStats> p, bool withUserspaceEntities) {
     setEnergyMeter(p);
 
-    addPixelStateResidencyDataProvider(p);
+    // Kept alive by the providers registered through it.
+    std::shared_ptr<ParallelStateResidencyDataProvider> fanOut;
+    const uint64_t fanOutThreads = android::base::GetUintProperty<uint64_t>(kFanOutThreadsProp, 0);
+    if (fanOutThreads > 0) {
+        fanOut = std::make_shared<ParallelStateResidencyDataProvider>(fanOutThreads,
+                std::chrono::milliseconds(android::base::GetUintProperty<uint64_t>(
+                        kFanOutDeadlineProp, kDefaultFanOutDeadlineMs)));
+        sFanOut = fanOut.get();
+    }
+
+    if (withUserspaceEntities) {
+        addPixelStateResidencyDataProvider(p);
+    }
     addAoC(p);
     addDvfsStats(p);
     addSoC(p);
@@ -626,27 +666,22 @@ void addGs201CommonDataProviders(std::shared_ptr<PowerStats> p) {
     addDevfreq(p);
     addTPU(p);
     addCamera(p);
+
+    sFanOut = nullptr;
 }
 
-void addNFC(std::shared_ptr<PowerStats> p, const std::string& path) {
-    const GenericStateResidencyDataProvider::StateResidencyConfig nfcStateConfig = {
-        .entryCountSupported = true,
-        .entryCountPrefix = "Cumulative count:",
-        .totalTimeSupported = true,
-        .totalTimePrefix = "Cumulative duration msec:",
-        .lastEntrySupported = true,
-        .lastEntryPrefix = "Last entry timestamp msec:",
-    };
-    const std::vector<std::pair<std::string, std::string>> nfcStateHeaders = {
-        std::make_pair("IDLE", "Idle mode:"),
-        std::make_pair("ACTIVE", "Active mode:"),
-        std::make_pair("ACTIVE-RW", "Active Reader/Writer mode:"),
-    };
+void addGs201CommonDataProviders(std::shared_ptr<PowerStats> p) {
+    addCommonDataProviders(p, true);
+    if (!sDumpServer) {
+        sDumpServer = new PowerStatsDumpServer(p.get());
+        sDumpServer->start();
+    }
+}
 
-    std::vector<GenericStateResidencyDataProvider::PowerEntityConfig> cfgs;
-    cfgs.emplace_back(generateGenericStateResidencyConfigs(nfcStateConfig, nfcStateHeaders),
-            "NFC", "NFC subsystem");
+void addGs201KernelDataProviders(std::shared_ptr<PowerStats> p) {
+    addCommonDataProviders(p, false);
+}
 
-    p->addStateResidencyDataProvider(std::make_unique<GenericStateResidencyDataProvider>(
-            path, cfgs));
+void addNFC(std::shared_ptr<PowerStats> p, const std::string& path) {
+    addBufferedDataProvider(p, remapPath(path), gs201::kNfcEntities);
 }
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Gs201PowerStats.h"
+
+#include "PowerStatsDumpServer.h"
+#include "ProviderTelemetry.h"
+
+#include <android-base/chrono_utils.h>
+#include <android-base/file.h>
+#include <android-base/logging.h>
+#include <android-base/parseint.h>
+#include <android-base/properties.h>
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+
+#include <unistd.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+// Roughly an hour of history for a client polling every entity once a minute.
+static constexpr size_t kHistoryBytes = 64 * 1024;
+
+// Window within which getStateResidency callers share one collection. 0 collects on every call.
+static const char *const kCoalesceProp = "persist.vendor.powerstats.coalesce_ms";
+
+Gs201PowerStats::Gs201PowerStats()
+    : Gs201PowerStats(std::chrono::milliseconds(
+              ::android::base::GetUintProperty<uint64_t>(kCoalesceProp, 0))) {}
+
+Gs201PowerStats::Gs201PowerStats(std::chrono::milliseconds coalesceWindow)
+    : mHistory(kHistoryBytes), kCoalesceWindow(coalesceWindow) {}
+
+int64_t Gs201PowerStats::getResidencySince(int64_t sinceMs,
+                                           std::vector<StateResidencyResult> *results) {
+    return mHistory.getResidencySince(sinceMs, results);
+}
+
+std::vector<int32_t> Gs201PowerStats::getPowerEntityIds() {
+    std::vector<PowerEntity> entities;
+    getPowerEntityInfo(&entities);
+    std::vector<int32_t> ids;
+    ids.reserve(entities.size());
+    for (const PowerEntity &entity : entities) {
+        ids.push_back(entity.id);
+    }
+    return ids;
+}
+
+ndk::ScopedAStatus Gs201PowerStats::collect(const std::vector<int32_t> &in_powerEntityIds,
+                                            std::vector<StateResidencyResult> *_aidl_return) {
+    // PowerStats expands an empty list itself and dispatches it back to getStateResidency, which
+    // would record the query twice. Passing every id keeps the call in the base class.
+    ndk::ScopedAStatus status = PowerStats::getStateResidency(
+            in_powerEntityIds.empty() ? getPowerEntityIds() : in_powerEntityIds, _aidl_return);
+    if (status.isOk()) {
+        const int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      ::android::base::boot_clock::now().time_since_epoch())
+                                      .count();
+        mHistory.record(nowMs, *_aidl_return);
+    }
+    return status;
+}
+
+bool Gs201PowerStats::isCollectionFreshLocked() const {
+    return mCollection &&
+           std::chrono::steady_clock::now() - mCollection->completed <= kCoalesceWindow;
+}
+
+std::shared_ptr<const Gs201PowerStats::Collection> Gs201PowerStats::getCompletedCollection() {
+    std::lock_guard<std::mutex> lock(mCollectionLock);
+    return isCollectionFreshLocked() ? mCollection : nullptr;
+}
+
+std::shared_ptr<const Gs201PowerStats::Collection> Gs201PowerStats::getCollection() {
+    std::unique_lock<std::mutex> lock(mCollectionLock);
+    if (mCollecting) {
+        // Join the collection in flight. It may fail, in which case there is nothing to share.
+        const uint64_t generation = mGeneration;
+        mCollectionCv.wait(lock, [&] { return mGeneration != generation; });
+        return mCollection;
+    }
+    if (isCollectionFreshLocked()) {
+        return mCollection;
+    }
+    mCollecting = true;
+    lock.unlock();
+
+    std::shared_ptr<Collection> collection = std::make_shared<Collection>();
+    if (collect({}, &collection->results).isOk()) {
+        std::vector<PowerEntity> entities;
+        getPowerEntityInfo(&entities);
+        collection->index.assign(entities.size(), -1);
+        for (size_t i = 0; i < collection->results.size(); i++) {
+            const int32_t id = collection->results[i].id;
+            if (id >= 0 && id < collection->index.size()) {
+                collection->index[id] = i;
+            }
+        }
+        collection->completed = std::chrono::steady_clock::now();
+    } else {
+        collection.reset();
+    }
+
+    lock.lock();
+    mCollection = collection;
+    mCollecting = false;
+    mGeneration++;
+    lock.unlock();
+    mCollectionCv.notify_all();
+    return collection;
+}
+
+ndk::ScopedAStatus Gs201PowerStats::getStateResidency(
+        const std::vector<int32_t> &in_powerEntityIds,
+        std::vector<StateResidencyResult> *_aidl_return) {
+    if (kCoalesceWindow.count() == 0) {
+        return collect(in_powerEntityIds, _aidl_return);
+    }
+
+    // A query of every entity joins or starts a shared collection. A narrower query is only served
+    // from a collection that completed within the window: collecting every entity for it, or
+    // waiting for a collection in flight, could take far longer than reading its own entities.
+    const std::shared_ptr<const Collection> collection =
+            in_powerEntityIds.empty() ? getCollection() : getCompletedCollection();
+    if (!collection) {
+        return collect(in_powerEntityIds, _aidl_return);
+    }
+
+    // If in_powerEntityIds is empty then return data for all supported entities
+    if (in_powerEntityIds.empty()) {
+        _aidl_return->insert(_aidl_return->end(), collection->results.begin(),
+                             collection->results.end());
+        return ndk::ScopedAStatus::ok();
+    }
+
+    for (const int32_t id : in_powerEntityIds) {
+        if (id < 0 || id >= collection->index.size()) {
+            return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_ARGUMENT);
+        }
+    }
+    _aidl_return->reserve(in_powerEntityIds.size());
+    for (const int32_t id : in_powerEntityIds) {
+        // Entities whose provider failed in the shared collection are left out.
+        if (collection->index[id] >= 0) {
+            _aidl_return->push_back(collection->results[collection->index[id]]);
+        }
+    }
+    return ndk::ScopedAStatus::ok();
+}
+
+void Gs201PowerStats::dumpResidencySince(int64_t sinceMs, std::ostringstream &oss) {
+    std::vector<PowerEntity> entities;
+    getPowerEntityInfo(&entities);
+
+    std::vector<StateResidencyResult> results;
+    const int64_t answeredMs = getResidencySince(sinceMs, &results);
+
+    oss << "\n============= PowerStats HAL 2.0 state residencies since " << answeredMs
+        << " ms ==============\n";
+    oss << std::setw(20) << std::left << "Entity" << std::setw(20) << "State"
+        << std::setw(14) << std::right << "TimeMs" << std::setw(10) << "Count"
+        << std::setw(16) << "LastEntryMs" << "\n";
+
+    for (const auto &result : results) {
+        if (result.id < 0 || result.id >= entities.size()) {
+            continue;
+        }
+        const PowerEntity &entity = entities[result.id];
+        for (const auto &sr : result.stateResidencyData) {
+            std::string_view stateName = "?";
+            for (const auto &state : entity.states) {
+                if (state.id == sr.id) {
+                    stateName = state.name;
+                    break;
+                }
+            }
+            oss << std::setw(20) << std::left << entity.name << std::setw(20) << stateName
+                << std::setw(14) << std::right << sr.totalTimeInStateMs << std::setw(10)
+                << sr.totalStateEntryCount << std::setw(16) << sr.lastEntryTimestampMs << "\n";
+        }
+    }
+    oss << "========== End of PowerStats HAL 2.0 state residencies since ===========\n";
+}
+
+binder_status_t Gs201PowerStats::dump(int fd, const char **args, uint32_t numArgs) {
+    if (numArgs == 2 && std::string_view(args[0]) == "--since") {
+        int64_t sinceMs;
+        if (!::android::base::ParseInt(args[1], &sinceMs)) {
+            ::android::base::WriteStringToFd("Invalid timestamp: " + std::string(args[1]) + "\n",
+                                             fd);
+            return STATUS_BAD_VALUE;
+        }
+        std::ostringstream oss;
+        dumpResidencySince(sinceMs, oss);
+        ::android::base::WriteStringToFd(oss.str(), fd);
+        fsync(fd);
+        return STATUS_OK;
+    }
+
+    std::string out;
+    binder_status_t status;
+    if (dumpPowerStatsArgs(this, std::vector<std::string_view>(args, args + numArgs), &out,
+                           &status)) {
+        ::android::base::WriteStringToFd(out, fd);
+        fsync(fd);
+        return status;
+    }
+
+    status = PowerStats::dump(fd, args, numArgs);
+    if (status != STATUS_OK) {
+        return status;
+    }
+    std::ostringstream oss;
+    dumpProviderCounters(oss);
+    ::android::base::WriteStringToFd(oss.str(), fd);
+    fsync(fd);
+    return STATUS_OK;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IncrementalAttributionEnergyConsumer.h"
+
+#include "DecimalScanner.h"
+
+#include <android-base/logging.h>
+
+#include <algorithm>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+static uint64_t hashRow(std::string_view row) {
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325;
+    for (char c : row) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+    }
+    return hash;
+}
+
+static std::string_view nextLine(std::string_view buf, size_t *pos) {
+    size_t end = buf.find('\n', *pos);
+    if (end == std::string_view::npos) {
+        end = buf.size();
+    }
+    const std::string_view line = buf.substr(*pos, end - *pos);
+    *pos = end + 1;
+    return line;
+}
+
+static std::string_view nextToken(std::string_view s, size_t *pos) {
+    while (*pos < s.size() && s[*pos] == ' ') {
+        (*pos)++;
+    }
+    const size_t begin = *pos;
+    while (*pos < s.size() && s[*pos] != ' ') {
+        (*pos)++;
+    }
+    return s.substr(begin, *pos - begin);
+}
+
+IncrementalAttributionEnergyConsumer::IncrementalAttributionEnergyConsumer(
+        CoalescedEnergyMeterDataProvider *meter, EnergyConsumerType type, std::string name,
+        const std::vector<std::string> &channels, std::string uidTimeInStatePath,
+        std::map<std::string, int32_t> stateCoeffs)
+    : kType(type),
+      kName(std::move(name)),
+      mMeter(meter),
+      kStateCoeffs(std::move(stateCoeffs)),
+      mFile(std::move(uidTimeInStatePath)) {
+    for (const auto &channel : channels) {
+        const int32_t id = mMeter->getChannelId(channel);
+        if (id < 0) {
+            LOG(ERROR) << __func__ << ": " << kName << ": unknown channel " << channel;
+            continue;
+        }
+        mChannelIds.push_back(id);
+    }
+}
+
+void IncrementalAttributionEnergyConsumer::updateHeader(std::string_view header) {
+    const uint64_t hash = hashRow(header);
+    if (hash == mHeaderHash && !mCoeffs.empty()) {
+        return;
+    }
+
+    // The states changed, previous snapshots cannot be compared with the next ones.
+    mHeaderHash = hash;
+    mCoeffs.clear();
+    mRows.clear();
+    mHasBaseline = false;
+
+    size_t pos = 0;
+    nextToken(header, &pos);  // "uid:"
+    for (std::string_view state = nextToken(header, &pos); !state.empty();
+         state = nextToken(header, &pos)) {
+        const auto it = kStateCoeffs.find(std::string(state));
+        mCoeffs.push_back(it == kStateCoeffs.end() ? 0 : it->second);
+    }
+}
+
+int64_t IncrementalAttributionEnergyConsumer::updateRow(int32_t uid, std::string_view row) {
+    // Rows are listed in UID order, so the next row is usually right after the previous one.
+    auto it = mRows.begin() + std::min(mRowHint, mRows.size());
+    if (it == mRows.end() || it->uid != uid) {
+        it = std::lower_bound(mRows.begin(), mRows.end(), uid,
+                              [](const UidRow &r, int32_t u) { return r.uid < u; });
+    }
+    const uint64_t hash = hashRow(row);
+    bool isNew = false;
+    if (it == mRows.end() || it->uid != uid) {
+        it = mRows.insert(it, {.uid = uid,
+                               .hash = 0,
+                               .times = std::vector<uint64_t>(mCoeffs.size())});
+        isNew = true;
+    }
+    it->generation = mGeneration;
+    mRowHint = it - mRows.begin() + 1;
+    if (!isNew && it->hash == hash) {
+        return 0;
+    }
+    it->hash = hash;
+
+    int64_t weight = 0;
+    size_t pos = 0;
+    for (size_t col = 0; col < mCoeffs.size(); col++) {
+        const std::string_view token = nextToken(row, &pos);
+        size_t len = 0;
+        const uint64_t time = parseDecimal(token, &len);
+        if (len == 0) {
+            break;
+        }
+        // Counters going backwards, e.g. after a UID was removed and reused, count as reset.
+        const uint64_t old = it->times[col];
+        if (mHasBaseline && time > old) {
+            weight += static_cast<int64_t>(time - old) * mCoeffs[col];
+        }
+        it->times[col] = time;
+    }
+    return weight;
+}
+
+void IncrementalAttributionEnergyConsumer::attribute(int64_t energyUWs, int64_t totalWeight) {
+    if (energyUWs <= 0 || totalWeight <= 0) {
+        return;
+    }
+    for (const auto &[uid, weight] : mChanged) {
+        const int64_t share =
+                static_cast<int64_t>(static_cast<__int128>(energyUWs) * weight / totalWeight);
+        auto it = std::lower_bound(
+                mAttribution.begin(), mAttribution.end(), uid,
+                [](const EnergyConsumerAttribution &a, int32_t u) { return a.uid < u; });
+        if (it == mAttribution.end() || it->uid != uid) {
+            it = mAttribution.insert(it, {.uid = uid, .energyUWs = 0});
+        }
+        it->energyUWs += share;
+    }
+}
+
+void IncrementalAttributionEnergyConsumer::pruneRows() {
+    // Both are sorted by UID, so the attribution of the UIDs that are gone is dropped in one pass.
+    auto attribution = mAttribution.begin();
+    auto kept = mAttribution.begin();
+    for (const UidRow &row : mRows) {
+        if (row.generation != mGeneration) {
+            continue;
+        }
+        while (attribution != mAttribution.end() && attribution->uid < row.uid) {
+            attribution++;
+        }
+        if (attribution != mAttribution.end() && attribution->uid == row.uid) {
+            *kept++ = *attribution++;
+        }
+    }
+    mAttribution.erase(kept, mAttribution.end());
+
+    mRows.erase(std::remove_if(mRows.begin(), mRows.end(),
+                               [this](const UidRow &row) { return row.generation != mGeneration; }),
+                mRows.end());
+}
+
+std::optional<EnergyConsumerResult> IncrementalAttributionEnergyConsumer::getEnergyConsumed() {
+    std::lock_guard<std::mutex> lock(mLock);
+
+    int64_t energyUWs = 0;
+    int64_t timestampMs = 0;
+    if (!mChannelIds.empty()) {
+        std::vector<EnergyMeasurement> measurements;
+        if (!mMeter->readEnergyMeter(mChannelIds, &measurements).isOk()) {
+            LOG(ERROR) << "Failed to read energy meter";
+            return {};
+        }
+        for (const auto &m : measurements) {
+            energyUWs += m.energyUWs;
+            timestampMs = m.timestampMs;
+        }
+    }
+
+    size_t used = 0;
+    if (mFile.read(&mBuffer, &used)) {
+        const std::string_view buf(mBuffer.data(), used);
+        size_t pos = 0;
+        updateHeader(nextLine(buf, &pos));
+
+        mChanged.clear();
+        mRowHint = 0;
+        mGeneration++;
+        int64_t totalWeight = 0;
+        while (pos < buf.size()) {
+            const std::string_view line = nextLine(buf, &pos);
+            size_t len = 0;
+            const uint64_t uid = parseDecimal(line, &len);
+            if (len == 0 || len == line.size() || line[len] != ':') {
+                continue;
+            }
+            const int64_t weight = updateRow(static_cast<int32_t>(uid), line.substr(len + 1));
+            if (weight > 0) {
+                mChanged.emplace_back(static_cast<int32_t>(uid), weight);
+                totalWeight += weight;
+            }
+        }
+
+        if (mHasBaseline) {
+            attribute(energyUWs - mLastEnergyUWs, totalWeight);
+        }
+        pruneRows();
+        mHasBaseline = true;
+        mLastEnergyUWs = energyUWs;
+    }
+
+    return EnergyConsumerResult{.timestampMs = timestampMs,
+                                .energyUWs = energyUWs,
+                                .attribution = mAttribution};
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
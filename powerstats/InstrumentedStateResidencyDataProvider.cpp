@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "InstrumentedStateResidencyDataProvider.h"
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+InstrumentedStateResidencyDataProvider::InstrumentedStateResidencyDataProvider(
+        const std::string &name, std::unique_ptr<PowerStats::IStateResidencyDataProvider> provider)
+    : mCounters(getProviderCounters(name)), mProvider(std::move(provider)) {}
+
+bool InstrumentedStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    ScopedProviderCall call(mCounters);
+    const bool ok = mProvider->getStateResidencies(residencies);
+    if (!ok) {
+        call.setFailed();
+    }
+    return ok;
+}
+
+std::unordered_map<std::string, std::vector<State>>
+InstrumentedStateResidencyDataProvider::getInfo() {
+    return mProvider->getInfo();
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
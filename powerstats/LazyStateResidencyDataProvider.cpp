@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LazyStateResidencyDataProvider.h"
+
+#include <android-base/logging.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+LazyStateResidencyDataProvider::LazyStateResidencyDataProvider(
+        std::unordered_map<std::string, std::vector<State>> info, Factory factory)
+    : mInfo(std::move(info)), mFactory(std::move(factory)) {}
+
+bool LazyStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    std::lock_guard<std::mutex> lock(mLock);
+    if (mFactory) {
+        mProvider = mFactory();
+        // Release whatever the factory captured, it is never called again.
+        mFactory = nullptr;
+        if (!mProvider) {
+            LOG(ERROR) << __func__ << ":Failed to create provider";
+        }
+    }
+    return mProvider && mProvider->getStateResidencies(residencies);
+}
+
+std::unordered_map<std::string, std::vector<State>> LazyStateResidencyDataProvider::getInfo() {
+    return mInfo;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ParallelStateResidencyDataProvider.h"
+
+#include <android-base/logging.h>
+
+#include <pthread.h>
+
+#include <algorithm>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+ParallelStateResidencyDataProvider::ParallelStateResidencyDataProvider(
+        size_t numThreads, std::chrono::milliseconds deadline)
+    : kDeadline(deadline) {
+    for (size_t i = 0; i < numThreads; i++) {
+        mThreads.emplace_back([this, i] {
+            pthread_setname_np(pthread_self(), ("ps-fanout-" + std::to_string(i)).c_str());
+            workerLoop();
+        });
+    }
+}
+
+ParallelStateResidencyDataProvider::~ParallelStateResidencyDataProvider() {
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mStopping = true;
+    }
+    mWorkCv.notify_all();
+    for (auto &t : mThreads) {
+        t.join();
+    }
+}
+
+// Registered with PowerStats in place of a provider of the group, reads it through the group.
+class ParallelStateResidencyDataProvider::Proxy : public PowerStats::IStateResidencyDataProvider {
+  public:
+    Proxy(std::shared_ptr<ParallelStateResidencyDataProvider> group, Child *child)
+        : mGroup(std::move(group)), mChild(child) {}
+
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override {
+        return mGroup->read(mChild, residencies);
+    }
+
+    std::unordered_map<std::string, std::vector<State>> getInfo() override {
+        return mChild->provider->getInfo();
+    }
+
+  private:
+    const std::shared_ptr<ParallelStateResidencyDataProvider> mGroup;
+    Child *const mChild;
+};
+
+std::unique_ptr<PowerStats::IStateResidencyDataProvider>
+ParallelStateResidencyDataProvider::addDataProvider(
+        std::unique_ptr<PowerStats::IStateResidencyDataProvider> p) {
+    auto child = std::make_unique<Child>();
+    child->provider = std::move(p);
+    child->index = mChildren.size();
+    for (const auto &[entity, states] : child->provider->getInfo()) {
+        child->entities.push_back(entity);
+    }
+    mChildren.push_back(std::move(child));
+    return std::make_unique<Proxy>(shared_from_this(), mChildren.back().get());
+}
+
+void ParallelStateResidencyDataProvider::workerLoop() {
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true) {
+        mWorkCv.wait(lock, [this] { return mStopping || !mQueue.empty(); });
+        if (mStopping) {
+            return;
+        }
+
+        Child *child = mQueue.front();
+        mQueue.pop_front();
+
+        lock.unlock();
+        std::unordered_map<std::string, std::vector<StateResidency>> result;
+        bool status = child->provider->getStateResidencies(&result);
+        lock.lock();
+
+        child->lastResult = std::move(result);
+        child->lastStatus = status;
+        child->hasResult = true;
+        child->inFlight = false;
+        mDoneCv.notify_all();
+    }
+}
+
+void ParallelStateResidencyDataProvider::queueLocked(
+        Child *child, std::chrono::steady_clock::time_point now) {
+    // A provider still busy with a read an earlier query gave up on is served from cache.
+    if (child->inFlight || (child->hasResult && now - child->queued < 2 * kDeadline)) {
+        return;
+    }
+    child->inFlight = true;
+    child->queued = now;
+    child->deadline = now + kDeadline;
+    mQueue.push_back(child);
+    mWorkCv.notify_one();
+}
+
+bool ParallelStateResidencyDataProvider::read(
+        Child *child, std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    const auto now = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mLock);
+
+    // The query already read the previous provider, it is most likely reading all of them.
+    if (child->index > 0) {
+        const Child &previous = *mChildren[child->index - 1];
+        const bool readPrevious =
+                !previous.entities.empty() &&
+                std::all_of(previous.entities.begin(), previous.entities.end(),
+                            [&](const std::string &e) { return residencies->count(e) > 0; });
+        if (readPrevious) {
+            for (size_t i = child->index + 1; i < mChildren.size(); i++) {
+                queueLocked(mChildren[i].get(), now);
+            }
+        }
+    }
+    queueLocked(child, now);
+
+    if (!mDoneCv.wait_until(lock, child->deadline, [child] { return !child->inFlight; })) {
+        LOG(WARNING) << __func__ << ": provider missed the " << kDeadline.count()
+                     << "ms deadline, using its last result";
+    }
+    if (!child->hasResult) {
+        return false;
+    }
+    residencies->insert(child->lastResult.begin(), child->lastResult.end());
+    return child->lastStatus;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PowerEntityTable.h"
+
+#include "UnitConversion.h"
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+using StateResidencyConfig = GenericStateResidencyDataProvider::StateResidencyConfig;
+
+// Returns a transform StateResidencyParser applies without an indirect call.
+static std::function<uint64_t(uint64_t)> toMs(TimeUnit unit) {
+    switch (unit) {
+        case TimeUnit::US:
+            return UsToMs();
+        case TimeUnit::NS:
+            return NsToMs();
+        case TimeUnit::MS:
+        default:
+            return Identity();
+    }
+}
+
+std::vector<PowerEntityConfig> buildPowerEntityConfigs(TableRef<PowerEntityTable> entities) {
+    std::vector<PowerEntityConfig> cfgs;
+    cfgs.reserve(entities.size());
+    for (const PowerEntityTable &entity : entities) {
+        const StateFieldsTable &fields = *entity.fields;
+        std::vector<StateResidencyConfig> states;
+        states.reserve(entity.states.size());
+        for (const StateTable &state : entity.states) {
+            StateResidencyConfig config = {};
+            config.name = state.name;
+            config.header = state.key;
+            config.entryCountSupported = fields.entryCountSupported;
+            config.entryCountPrefix = fields.entryCountPrefix;
+            config.totalTimeSupported = fields.totalTimeSupported;
+            config.totalTimePrefix = fields.totalTimePrefix;
+            config.lastEntrySupported = fields.lastEntrySupported;
+            config.lastEntryPrefix = fields.lastEntryPrefix;
+            if (fields.totalTimeSupported) {
+                config.totalTimeTransform = toMs(fields.timeUnit);
+            }
+            if (fields.lastEntrySupported) {
+                config.lastEntryTransform = toMs(fields.timeUnit);
+            }
+            states.push_back(std::move(config));
+        }
+        cfgs.emplace_back(std::move(states), std::string(entity.name),
+                          std::string(entity.header));
+    }
+    return cfgs;
+}
+
+std::vector<DvfsStateResidencyDataProvider::Config> buildDvfsConfigs(
+        TableRef<DvfsEntityTable> entities) {
+    std::vector<DvfsStateResidencyDataProvider::Config> cfgs;
+    cfgs.reserve(entities.size());
+    for (const DvfsEntityTable &entity : entities) {
+        std::vector<std::pair<std::string, std::string>> states;
+        states.reserve(entity.states.size());
+        for (const StateTable &state : entity.states) {
+            states.emplace_back(state.name, state.key);
+        }
+        cfgs.push_back({std::string(entity.name), std::move(states)});
+    }
+    return cfgs;
+}
+
+std::vector<State> buildStates(TableRef<StateTable> states) {
+    std::vector<State> info;
+    info.reserve(states.size());
+    for (const StateTable &state : states) {
+        info.push_back({.id = static_cast<int32_t>(info.size()), .name = std::string(state.name)});
+    }
+    return info;
+}
+
+std::unordered_map<std::string, std::vector<State>> buildPowerEntityInfo(
+        TableRef<PowerEntityTable> entities) {
+    std::unordered_map<std::string, std::vector<State>> info;
+    for (const PowerEntityTable &entity : entities) {
+        info.emplace(entity.name, buildStates(entity.states));
+    }
+    return info;
+}
+
+std::unordered_map<std::string, std::vector<State>> buildPowerEntityInfo(
+        TableRef<StateTable> entities, TableRef<StateTable> states) {
+    std::unordered_map<std::string, std::vector<State>> info;
+    for (const StateTable &entity : entities) {
+        info.emplace(entity.name, buildStates(states));
+    }
+    return info;
+}
+
+std::map<std::string, int32_t> buildStateCoeffs(TableRef<StateCoeffTable> coeffs) {
+    std::map<std::string, int32_t> stateCoeffs;
+    for (const StateCoeffTable &entry : coeffs) {
+        stateCoeffs.emplace(entry.state, entry.coeff);
+    }
+    return stateCoeffs;
+}
+
+std::vector<std::string> buildStrings(TableRef<std::string_view> table) {
+    return std::vector<std::string>(table.begin(), table.end());
+}
+
+std::vector<std::pair<std::string, std::string>> buildPrefixedPairs(TableRef<StateTable> table,
+                                                                    const std::string &prefix) {
+    std::vector<std::pair<std::string, std::string>> pairs;
+    pairs.reserve(table.size());
+    for (const StateTable &entry : table) {
+        pairs.emplace_back(entry.name, prefix + std::string(entry.key));
+    }
+    return pairs;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PowerStatsDumpServer.h"
+
+#include "Gs201CommonDataProviders.h"
+#include "PowerStatsSnapshot.h"
+#include "ProviderTelemetry.h"
+
+#include <android-base/chrono_utils.h>
+#include <android-base/logging.h>
+#include <android-base/parseint.h>
+#include <private/android_filesystem_config.h>
+
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+using ::android::base::unique_fd;
+
+static constexpr int kListenBacklog = 4;
+
+static void dumpRailPower(int64_t startMs, int64_t endMs, std::ostringstream &oss) {
+    oss << "\n============= PowerStats HAL 2.0 rail power from " << startMs << " to " << endMs
+        << " ms ==============\n";
+    RailSampler *sampler = getRailSampler();
+    if (!sampler) {
+        oss << "No rails sampled, see persist.vendor.powerstats.odpm.rail_periods\n";
+        return;
+    }
+    oss << std::setw(24) << std::left << "Rail" << std::right << std::setw(14) << "StartMs"
+        << std::setw(14) << "EndMs" << std::setw(10) << "Samples" << std::setw(14) << "AvgUW"
+        << std::setw(14) << "PeakUW" << "\n";
+    for (const std::string &rail : sampler->getRailNames()) {
+        RailSampler::PowerWindow window;
+        if (!sampler->getPower(rail, startMs, endMs, &window)) {
+            oss << std::setw(24) << std::left << rail << " not enough samples\n";
+            continue;
+        }
+        oss << std::setw(24) << std::left << rail << std::right << std::setw(14)
+            << window.startMs << std::setw(14) << window.endMs << std::setw(10)
+            << window.numSamples << std::setw(14) << window.averageUW << std::setw(14)
+            << window.peakUW << "\n";
+    }
+    oss << "========== End of PowerStats HAL 2.0 rail power ===========\n";
+}
+
+static void dumpSnapshot(PowerStats *p, std::string *out) {
+    PowerStatsSnapshot snapshot;
+    snapshot.bootTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  ::android::base::boot_clock::now().time_since_epoch())
+                                  .count();
+    // A failed query leaves its section out, the rest of the snapshot is still useful.
+    p->getPowerEntityInfo(&snapshot.entities);
+    p->getStateResidency({}, &snapshot.residencies);
+    p->getEnergyMeterInfo(&snapshot.channels);
+    p->readEnergyMeter({}, &snapshot.measurements);
+    p->getEnergyConsumerInfo(&snapshot.consumers);
+    p->getEnergyConsumed({}, &snapshot.consumed);
+
+    const std::vector<uint8_t> bytes = encodeSnapshot(snapshot);
+    out->append(bytes.begin(), bytes.end());
+}
+
+bool dumpPowerStatsArgs(PowerStats *p, const std::vector<std::string_view> &args,
+                        std::string *out, binder_status_t *status) {
+    if (args.size() == 1 && args[0] == "--providers") {
+        std::ostringstream oss;
+        dumpProviderCounters(oss);
+        out->append(oss.str());
+        *status = STATUS_OK;
+        return true;
+    }
+
+    if ((args.size() == 2 || args.size() == 3) && args[0] == "--power") {
+        int64_t startMs;
+        int64_t endMs = std::numeric_limits<int64_t>::max();
+        if (!::android::base::ParseInt(std::string(args[1]), &startMs) ||
+            (args.size() == 3 && !::android::base::ParseInt(std::string(args[2]), &endMs))) {
+            out->append("Invalid interval\n");
+            *status = STATUS_BAD_VALUE;
+            return true;
+        }
+        std::ostringstream oss;
+        dumpRailPower(startMs, endMs, oss);
+        out->append(oss.str());
+        *status = STATUS_OK;
+        return true;
+    }
+
+    if (args.size() == 1 && args[0] == "--binary") {
+        dumpSnapshot(p, out);
+        *status = STATUS_OK;
+        return true;
+    }
+    return false;
+}
+
+// The client may have gone away: MSG_NOSIGNAL keeps that from raising SIGPIPE in the service.
+static bool sendFully(int fd, std::string_view data) {
+    while (!data.empty()) {
+        const ssize_t sent = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(sent);
+    }
+    return true;
+}
+
+PowerStatsDumpServer::~PowerStatsDumpServer() {
+    if (!mThread.joinable()) {
+        return;
+    }
+    const uint64_t value = 1;
+    if (write(mStopFd, &value, sizeof(value)) != sizeof(value)) {
+        PLOG(ERROR) << __func__ << ":Failed to stop server";
+    }
+    mThread.join();
+}
+
+void PowerStatsDumpServer::start() {
+    mStopFd.reset(eventfd(0, EFD_CLOEXEC));
+    mEpollFd.reset(epoll_create1(EPOLL_CLOEXEC));
+    mSocket.reset(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0));
+    if (mStopFd < 0 || mEpollFd < 0 || mSocket < 0) {
+        PLOG(ERROR) << __func__ << ":Failed to create server";
+        return;
+    }
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    // Abstract namespace: sun_path starts with a NUL and is not NUL terminated.
+    if (kSocketName.size() + 1 > sizeof(addr.sun_path)) {
+        LOG(ERROR) << __func__ << ": socket name too long: " << kSocketName;
+        return;
+    }
+    memcpy(addr.sun_path + 1, kSocketName.data(), kSocketName.size());
+    const socklen_t addrLength = offsetof(sockaddr_un, sun_path) + 1 + kSocketName.size();
+    if (bind(mSocket, reinterpret_cast<const sockaddr *>(&addr), addrLength) != 0 ||
+        listen(mSocket, kListenBacklog) != 0) {
+        PLOG(ERROR) << __func__ << ":Failed to listen on " << kSocketName;
+        return;
+    }
+
+    for (const int fd : {mStopFd.get(), mSocket.get()}) {
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            PLOG(ERROR) << __func__ << ":Failed to watch server fds";
+            return;
+        }
+    }
+
+    mThread = std::thread([this] {
+        pthread_setname_np(pthread_self(), "ps-dump");
+        serverLoop();
+    });
+}
+
+void PowerStatsDumpServer::serve(unique_fd client) {
+    ucred cred = {};
+    socklen_t credLength = sizeof(cred);
+    if (getsockopt(client, SOL_SOCKET, SO_PEERCRED, &cred, &credLength) != 0) {
+        PLOG(ERROR) << __func__ << ":Failed to get client credentials";
+        return;
+    }
+    if (cred.uid != AID_ROOT && cred.uid != AID_SYSTEM && cred.uid != AID_SHELL) {
+        LOG(WARNING) << __func__ << ": uid " << cred.uid << " may not dump";
+        return;
+    }
+    const timeval timeout = {.tv_sec = kClientTimeout.count()};
+    if (setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0 ||
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0) {
+        PLOG(ERROR) << __func__ << ":Failed to set client timeouts";
+        return;
+    }
+
+    std::string request;
+    char buffer[256];
+    while (true) {
+        const ssize_t size = recv(client, buffer, sizeof(buffer), 0);
+        if (size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            PLOG(WARNING) << __func__ << ":Failed to read request";
+            return;
+        }
+        if (size == 0) {
+            break;
+        }
+        request.append(buffer, size);
+        if (request.size() > kDumpMaxRequest) {
+            sendFully(client, "Request too long\n");
+            return;
+        }
+    }
+
+    std::vector<std::string_view> args;
+    size_t begin = 0;
+    for (size_t end; (end = request.find('\0', begin)) != std::string::npos; begin = end + 1) {
+        args.emplace_back(request.data() + begin, end - begin);
+    }
+    if (begin != request.size()) {
+        sendFully(client, "Malformed request\n");
+        return;
+    }
+    if (args.empty()) {
+        args.emplace_back("--providers");
+    }
+
+    std::string out;
+    binder_status_t status;
+    if (!dumpPowerStatsArgs(mPowerStats, args, &out, &status)) {
+        out = "Unknown arguments\n";
+    }
+    if (!sendFully(client, out)) {
+        PLOG(WARNING) << __func__ << ":Failed to send dump";
+    }
+}
+
+void PowerStatsDumpServer::serverLoop() {
+    epoll_event events[2];
+    while (true) {
+        const int count = epoll_wait(mEpollFd, events, std::size(events), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            PLOG(ERROR) << __func__ << ":Failed to wait for clients";
+            return;
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.fd == mStopFd) {
+                return;
+            }
+        }
+        // Accepted sockets do not inherit O_NONBLOCK, so clients are served blocking, bounded by
+        // their timeouts.
+        while (true) {
+            unique_fd client(accept4(mSocket, nullptr, nullptr, SOCK_CLOEXEC));
+            if (client < 0) {
+                break;
+            }
+            serve(std::move(client));
+        }
+    }
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
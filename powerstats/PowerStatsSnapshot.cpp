@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PowerStatsSnapshot.h"
+
+#include "PowerStatsSnapshotFormat.h"
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+using snapshot::putInt;
+using snapshot::putString;
+using snapshot::putUint;
+using snapshot::Section;
+
+template <typename T, typename Fn>
+static void putSection(Section tag, const std::vector<T> &items, Fn putItem,
+                       std::vector<uint8_t> *out) {
+    if (items.empty()) {
+        return;
+    }
+    std::vector<uint8_t> payload;
+    putUint(items.size(), &payload);
+    for (const T &item : items) {
+        putItem(item, &payload);
+    }
+    putUint(static_cast<uint64_t>(tag), out);
+    putUint(payload.size(), out);
+    out->insert(out->end(), payload.begin(), payload.end());
+}
+
+std::vector<uint8_t> encodeSnapshot(const PowerStatsSnapshot &s) {
+    std::vector<uint8_t> out(std::begin(snapshot::kMagic), std::end(snapshot::kMagic));
+    out.push_back(snapshot::kVersion);
+    putInt(s.bootTimeMs, &out);
+
+    putSection(Section::POWER_ENTITIES, s.entities,
+               [](const PowerEntity &entity, std::vector<uint8_t> *p) {
+                   putInt(entity.id, p);
+                   putString(entity.name, p);
+                   putUint(entity.states.size(), p);
+                   for (const State &state : entity.states) {
+                       putInt(state.id, p);
+                       putString(state.name, p);
+                   }
+               }, &out);
+    putSection(Section::STATE_RESIDENCIES, s.residencies,
+               [](const StateResidencyResult &result, std::vector<uint8_t> *p) {
+                   putInt(result.id, p);
+                   putUint(result.stateResidencyData.size(), p);
+                   for (const StateResidency &sr : result.stateResidencyData) {
+                       putInt(sr.id, p);
+                       putInt(sr.totalTimeInStateMs, p);
+                       putInt(sr.totalStateEntryCount, p);
+                       putInt(sr.lastEntryTimestampMs, p);
+                   }
+               }, &out);
+    putSection(Section::CHANNELS, s.channels, [](const Channel &channel, std::vector<uint8_t> *p) {
+        putInt(channel.id, p);
+        putString(channel.name, p);
+        putString(channel.subsystem, p);
+    }, &out);
+    putSection(Section::ENERGY_MEASUREMENTS, s.measurements,
+               [](const EnergyMeasurement &m, std::vector<uint8_t> *p) {
+                   putInt(m.id, p);
+                   putInt(m.timestampMs, p);
+                   putInt(m.durationMs, p);
+                   putInt(m.energyUWs, p);
+               }, &out);
+    putSection(Section::ENERGY_CONSUMERS, s.consumers,
+               [](const EnergyConsumer &consumer, std::vector<uint8_t> *p) {
+                   putInt(consumer.id, p);
+                   putInt(consumer.ordinal, p);
+                   putInt(static_cast<int64_t>(consumer.type), p);
+                   putString(consumer.name, p);
+               }, &out);
+    putSection(Section::ENERGY_CONSUMED, s.consumed,
+               [](const EnergyConsumerResult &result, std::vector<uint8_t> *p) {
+                   putInt(result.id, p);
+                   putInt(result.timestampMs, p);
+                   putInt(result.energyUWs, p);
+                   putUint(result.attribution.size(), p);
+                   for (const EnergyConsumerAttribution &a : result.attribution) {
+                       putInt(a.uid, p);
+                       putInt(a.energyUWs, p);
+                   }
+               }, &out);
+    return out;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PrefixMatcher.h"
+
+#include <map>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+PrefixMatcher::PrefixMatcher(const std::vector<std::string_view> &prefixes)
+    : mSize(prefixes.size()) {
+    struct BuildNode {
+        std::map<char, uint32_t> children;
+        std::vector<int32_t> ids;
+    };
+    std::vector<BuildNode> build(1);
+
+    for (int32_t id = 0; id < prefixes.size(); id++) {
+        uint32_t node = 0;
+        for (char c : prefixes[id]) {
+            auto it = build[node].children.find(c);
+            if (it != build[node].children.end()) {
+                node = it->second;
+                continue;
+            }
+            const uint32_t child = build.size();
+            build[node].children.emplace(c, child);
+            build.emplace_back();
+            node = child;
+        }
+        build[node].ids.push_back(id);
+    }
+
+    // Nodes keep their build order, edges are sorted by character thanks to std::map.
+    mNodes.reserve(build.size());
+    for (const BuildNode &b : build) {
+        Node n = {.firstEdge = static_cast<uint32_t>(mEdges.size()),
+                  .numEdges = static_cast<uint32_t>(b.children.size()),
+                  .firstId = static_cast<uint32_t>(mIds.size()),
+                  .numIds = static_cast<uint32_t>(b.ids.size())};
+        for (const auto &[c, child] : b.children) {
+            mEdges.push_back({c, child});
+        }
+        mIds.insert(mIds.end(), b.ids.begin(), b.ids.end());
+        mNodes.push_back(n);
+    }
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
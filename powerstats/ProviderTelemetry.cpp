@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define ATRACE_TAG ATRACE_TAG_POWER
+
+#include "ProviderTelemetry.h"
+
+#include <cutils/trace.h>
+
+#include <iomanip>
+#include <list>
+#include <mutex>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+static std::mutex sRegistryLock;
+// A list so that registering does not move the counters handed out.
+static std::list<ProviderCounters> sRegistry;
+
+static std::atomic<size_t> sNextShard{0};
+
+// Innermost provider call in progress on this thread.
+static thread_local ScopedProviderCall *tCall = nullptr;
+
+static size_t getShard(size_t numShards) {
+    static thread_local const size_t shard =
+            sNextShard.fetch_add(1, std::memory_order_relaxed);
+    return shard % numShards;
+}
+
+static size_t getLatencyBucket(std::chrono::nanoseconds latency, size_t numBuckets) {
+    uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    size_t bucket = 0;
+    while (us > 1 && bucket < numBuckets - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void ProviderCounters::record(std::chrono::nanoseconds latency, uint64_t bytesRead,
+                              uint64_t readErrors, bool failed, bool parseError) {
+    Shard &shard = mShards[getShard(kNumShards)];
+    shard.calls.fetch_add(1, std::memory_order_relaxed);
+    shard.totalNs.fetch_add(latency.count(), std::memory_order_relaxed);
+    shard.bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+    shard.failures.fetch_add(failed, std::memory_order_relaxed);
+    shard.readErrors.fetch_add(readErrors, std::memory_order_relaxed);
+    shard.parseErrors.fetch_add(parseError, std::memory_order_relaxed);
+    shard.latencyBuckets[getLatencyBucket(latency, kNumLatencyBuckets)].fetch_add(
+            1, std::memory_order_relaxed);
+}
+
+void ProviderCounters::recordSampleAge(std::chrono::milliseconds age) {
+    Shard &shard = mShards[getShard(kNumShards)];
+    shard.samplesServed.fetch_add(1, std::memory_order_relaxed);
+    shard.totalSampleAgeMs.fetch_add(age.count(), std::memory_order_relaxed);
+}
+
+void ProviderCounters::dump(std::ostream &os) const {
+    uint64_t calls = 0, totalNs = 0, bytesRead = 0, failures = 0, readErrors = 0, parseErrors = 0;
+    uint64_t samplesServed = 0, totalSampleAgeMs = 0;
+    uint64_t buckets[kNumLatencyBuckets] = {};
+    for (const Shard &shard : mShards) {
+        calls += shard.calls.load(std::memory_order_relaxed);
+        totalNs += shard.totalNs.load(std::memory_order_relaxed);
+        bytesRead += shard.bytesRead.load(std::memory_order_relaxed);
+        failures += shard.failures.load(std::memory_order_relaxed);
+        readErrors += shard.readErrors.load(std::memory_order_relaxed);
+        parseErrors += shard.parseErrors.load(std::memory_order_relaxed);
+        samplesServed += shard.samplesServed.load(std::memory_order_relaxed);
+        totalSampleAgeMs += shard.totalSampleAgeMs.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < kNumLatencyBuckets; i++) {
+            buckets[i] += shard.latencyBuckets[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Percentiles are reported as the upper bound of the bucket they fall in.
+    auto percentileUs = [&](uint64_t percent) -> uint64_t {
+        const uint64_t rank = (calls * percent + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kNumLatencyBuckets; i++) {
+            seen += buckets[i];
+            if (seen >= rank && seen > 0) {
+                return uint64_t(2) << i;
+            }
+        }
+        return 0;
+    };
+
+    os << std::setw(28) << std::left << kName << std::right << std::setw(10) << calls
+       << std::setw(10) << (calls ? totalNs / calls / 1000 : 0) << std::setw(10)
+       << percentileUs(50) << std::setw(10) << percentileUs(99) << std::setw(12)
+       << (calls ? bytesRead / calls : 0) << std::setw(9) << failures << std::setw(9)
+       << readErrors << std::setw(9) << parseErrors << std::setw(10)
+       << (samplesServed ? std::to_string(totalSampleAgeMs / samplesServed) : "-") << "\n";
+}
+
+ProviderCounters *getProviderCounters(const std::string &name) {
+    std::lock_guard<std::mutex> lock(sRegistryLock);
+    for (ProviderCounters &counters : sRegistry) {
+        if (counters.getName() == name) {
+            return &counters;
+        }
+    }
+    return &sRegistry.emplace_back(name);
+}
+
+void dumpProviderCounters(std::ostream &os) {
+    os << "\n============= PowerStats HAL 2.0 provider counters ==============\n";
+    os << std::setw(28) << std::left << "Provider" << std::right << std::setw(10) << "Calls"
+       << std::setw(10) << "AvgUs" << std::setw(10) << "P50Us" << std::setw(10) << "P99Us"
+       << std::setw(12) << "Bytes/call" << std::setw(9) << "Failed" << std::setw(9)
+       << "ReadErr" << std::setw(9) << "ParseErr" << std::setw(10) << "AvgAgeMs" << "\n";
+
+    std::lock_guard<std::mutex> lock(sRegistryLock);
+    for (const ProviderCounters &counters : sRegistry) {
+        counters.dump(os);
+    }
+    os << "========== End of PowerStats HAL 2.0 provider counters ===========\n";
+}
+
+void countBytesRead(size_t bytes) {
+    for (ScopedProviderCall *call = tCall; call; call = call->mParent) {
+        call->mBytesRead += bytes;
+    }
+}
+
+void countReadError() {
+    for (ScopedProviderCall *call = tCall; call; call = call->mParent) {
+        call->mReadErrors++;
+    }
+}
+
+ScopedProviderCall::ScopedProviderCall(ProviderCounters *counters)
+    : mCounters(counters), mParent(tCall), mStart(std::chrono::steady_clock::now()) {
+    tCall = this;
+    ATRACE_BEGIN(mCounters->getName().c_str());
+}
+
+ScopedProviderCall::~ScopedProviderCall() {
+    ATRACE_END();
+    tCall = mParent;
+    mCounters->record(std::chrono::steady_clock::now() - mStart, mBytesRead, mReadErrors, mFailed,
+                      mFailed && mReadErrors == 0 && mBytesRead > 0);
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,315 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PushStateResidencyDataProvider.h"
+
+#include <android-base/chrono_utils.h>
+#include <android-base/logging.h>
+
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+using ::android::base::unique_fd;
+
+static constexpr int kListenBacklog = 16;
+
+static int64_t getBootTimeMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   ::android::base::boot_clock::now().time_since_epoch())
+            .count();
+}
+
+bool PushStateResidencyDataProvider::Queue::push(const Transition &transition) {
+    const size_t head = mHead.load(std::memory_order_relaxed);
+    if (head - mTail.load(std::memory_order_acquire) == kCapacity) {
+        return false;
+    }
+    mSlots[head % kCapacity] = transition;
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool PushStateResidencyDataProvider::Queue::pop(Transition *transition) {
+    const size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail == mHead.load(std::memory_order_acquire)) {
+        return false;
+    }
+    *transition = mSlots[tail % kCapacity];
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+PushStateResidencyDataProvider::~PushStateResidencyDataProvider() {
+    if (!mThread.joinable()) {
+        return;
+    }
+    const uint64_t value = 1;
+    if (write(mStopFd, &value, sizeof(value)) != sizeof(value)) {
+        PLOG(ERROR) << __func__ << ":Failed to stop receiver";
+    }
+    mThread.join();
+}
+
+void PushStateResidencyDataProvider::addEntity(const std::string &name,
+                                               const std::vector<State> &states, uid_t clientUid) {
+    Entity entity = {.name = name, .states = states, .clientUid = clientUid};
+    for (const State &state : states) {
+        entity.residencies.push_back({.id = state.id});
+    }
+    mEntities.push_back(std::move(entity));
+}
+
+void PushStateResidencyDataProvider::start() {
+    mStopFd.reset(eventfd(0, EFD_CLOEXEC));
+    mEpollFd.reset(epoll_create1(EPOLL_CLOEXEC));
+    mSocket.reset(socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0));
+    if (mStopFd < 0 || mEpollFd < 0 || mSocket < 0) {
+        PLOG(ERROR) << __func__ << ":Failed to create receiver";
+        return;
+    }
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    // Abstract namespace: sun_path starts with a NUL and is not NUL terminated.
+    constexpr size_t kNameLength = sizeof(kPushSocketName) - 1;
+    static_assert(kNameLength + 1 <= sizeof(addr.sun_path));
+    memcpy(addr.sun_path + 1, kPushSocketName, kNameLength);
+    const socklen_t addrLength = offsetof(sockaddr_un, sun_path) + 1 + kNameLength;
+    if (bind(mSocket, reinterpret_cast<const sockaddr *>(&addr), addrLength) != 0 ||
+        listen(mSocket, kListenBacklog) != 0) {
+        PLOG(ERROR) << __func__ << ":Failed to listen on " << kPushSocketName;
+        return;
+    }
+
+    for (const int fd : {mStopFd.get(), mSocket.get()}) {
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            PLOG(ERROR) << __func__ << ":Failed to watch receiver fds";
+            return;
+        }
+    }
+
+    mThread = std::thread([this] {
+        pthread_setname_np(pthread_self(), "ps-push");
+        receiverLoop();
+    });
+}
+
+void PushStateResidencyDataProvider::enqueue(const Transition &transition) {
+    if (mQueue.push(transition)) {
+        return;
+    }
+    // Rare: no query drained the queue for a long while. Drain it here rather than drop anything.
+    std::lock_guard<std::mutex> lock(mLock);
+    drain();
+    mQueue.push(transition);
+}
+
+void PushStateResidencyDataProvider::drain() {
+    Transition transition;
+    while (mQueue.pop(&transition)) {
+        apply(transition);
+    }
+}
+
+void PushStateResidencyDataProvider::apply(const Transition &transition) {
+    Entity &entity = mEntities[transition.entity];
+    // Transitions of different clients of one entity may arrive slightly out of order.
+    const int64_t timestampMs = std::max(transition.timestampMs, entity.enteredMs);
+    if (entity.current >= 0) {
+        entity.residencies[entity.current].totalTimeInStateMs += timestampMs - entity.enteredMs;
+    }
+
+    const ssize_t previous = entity.current;
+    entity.current = -1;
+    for (size_t i = 0; i < entity.states.size(); i++) {
+        if (entity.states[i].id == transition.stateId) {
+            entity.current = i;
+            break;
+        }
+    }
+    if (entity.current >= 0 && entity.current != previous) {
+        StateResidency &residency = entity.residencies[entity.current];
+        residency.totalStateEntryCount++;
+        residency.lastEntryTimestampMs = timestampMs;
+    }
+    entity.enteredMs = timestampMs;
+}
+
+bool PushStateResidencyDataProvider::getStateResidencies(
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) {
+    const int64_t nowMs = getBootTimeMs();
+    std::lock_guard<std::mutex> lock(mLock);
+    drain();
+    for (const Entity &entity : mEntities) {
+        std::vector<StateResidency> result = entity.residencies;
+        if (entity.current >= 0) {
+            result[entity.current].totalTimeInStateMs += std::max<int64_t>(
+                    nowMs - entity.enteredMs, 0);
+        }
+        residencies->emplace(entity.name, std::move(result));
+    }
+    return true;
+}
+
+std::unordered_map<std::string, std::vector<State>> PushStateResidencyDataProvider::getInfo() {
+    std::unordered_map<std::string, std::vector<State>> info;
+    for (const Entity &entity : mEntities) {
+        info.emplace(entity.name, entity.states);
+    }
+    return info;
+}
+
+void PushStateResidencyDataProvider::acceptClients() {
+    while (true) {
+        unique_fd clientFd(accept4(mSocket, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK));
+        if (clientFd < 0) {
+            return;
+        }
+        if (mClients.size() >= kMaxClients) {
+            LOG(WARNING) << __func__ << ": too many clients, closing new one";
+            continue;
+        }
+        ucred cred = {};
+        socklen_t credLength = sizeof(cred);
+        if (getsockopt(clientFd, SOL_SOCKET, SO_PEERCRED, &cred, &credLength) != 0) {
+            PLOG(ERROR) << __func__ << ":Failed to get client credentials";
+            continue;
+        }
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = clientFd.get();
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, clientFd, &ev) != 0) {
+            PLOG(ERROR) << __func__ << ":Failed to watch client";
+            continue;
+        }
+        const int key = clientFd.get();
+        mClients[key] = {.fd = std::move(clientFd), .uid = cred.uid};
+    }
+}
+
+bool PushStateResidencyDataProvider::receive(Client *client) {
+    PushTransition batch[kPushMaxBatch];
+    while (true) {
+        // MSG_TRUNC returns the full length of the message, so oversized ones can be told apart.
+        const ssize_t size = recv(client->fd, batch, sizeof(batch), MSG_TRUNC | MSG_DONTWAIT);
+        if (size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        if (size == 0 || size > sizeof(batch)) {
+            return false;
+        }
+
+        if (client->entity < 0) {
+            const std::string_view name(reinterpret_cast<const char *>(batch), size);
+            const auto entity = std::find_if(mEntities.begin(), mEntities.end(),
+                                             [&](const Entity &e) { return e.name == name; });
+            if (entity == mEntities.end()) {
+                LOG(WARNING) << __func__ << ": unknown entity " << name;
+                return false;
+            }
+            if (entity->clientUid != client->uid) {
+                LOG(WARNING) << __func__ << ": uid " << client->uid << " may not report " << name;
+                return false;
+            }
+            client->entity = entity - mEntities.begin();
+            entity->numClients++;
+            continue;
+        }
+
+        if (size % sizeof(PushTransition) != 0) {
+            LOG(WARNING) << __func__ << ": malformed batch for " << mEntities[client->entity].name;
+            return false;
+        }
+        // A transition cannot have happened yet. Clamping keeps a client from crediting time to
+        // a state ahead of the queries.
+        const int64_t nowMs = getBootTimeMs();
+        for (size_t i = 0; i < size / sizeof(PushTransition); i++) {
+            enqueue({.entity = static_cast<size_t>(client->entity),
+                     .stateId = batch[i].stateId,
+                     .timestampMs = std::min(batch[i].timestampMs, nowMs)});
+        }
+    }
+}
+
+void PushStateResidencyDataProvider::receiverLoop() {
+    epoll_event events[16];
+    while (true) {
+        const int count = epoll_wait(mEpollFd, events, std::size(events), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            PLOG(ERROR) << __func__ << ":Failed to wait for clients";
+            return;
+        }
+
+        for (int i = 0; i < count; i++) {
+            const int fd = events[i].data.fd;
+            if (fd == mStopFd) {
+                return;
+            }
+
+            if (fd == mSocket) {
+                acceptClients();
+                continue;
+            }
+
+            auto client = mClients.find(fd);
+            if (client == mClients.end() || receive(&client->second)) {
+                continue;
+            }
+            // Once the last client of an entity went away, its state is unknown until one
+            // reconnects.
+            const ssize_t entity = client->second.entity;
+            if (entity >= 0 && --mEntities[entity].numClients == 0) {
+                enqueue({.entity = static_cast<size_t>(entity),
+                         .stateId = kPushUnknownState,
+                         .timestampMs = getBootTimeMs()});
+            }
+            epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+            mClients.erase(client);
+        }
+    }
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RailSampler.h"
+
+#include <android-base/logging.h>
+#include <android-base/parseint.h>
+#include <android-base/strings.h>
+
+#include <pthread.h>
+
+#include <algorithm>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+// Every sample reads the PMICs over SPMI and wakes the sampler thread, and the meter itself only
+// accumulates energy every few milliseconds, so faster sampling costs more than it resolves.
+static constexpr std::chrono::milliseconds kMinPeriod(100);
+static constexpr size_t kMinRingCapacity = 16;
+
+static size_t getRingCapacity(std::chrono::milliseconds period) {
+    const size_t samples = std::chrono::milliseconds(RailSampler::kHistory) / period;
+    size_t capacity = kMinRingCapacity;
+    while (capacity < samples) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+RailSampler::Ring::Ring(size_t capacity)
+    : kMask(capacity - 1), mSamples(std::make_unique<Sample[]>(capacity)) {}
+
+void RailSampler::Ring::push(int64_t timestampMs, int64_t energyUWs) {
+    const uint64_t head = mHead.load(std::memory_order_relaxed);
+    Sample &sample = mSamples[head & kMask];
+    const uint64_t sequence = sample.sequence.load(std::memory_order_relaxed);
+    sample.sequence.store(sequence + 1, std::memory_order_relaxed);
+    // Orders the odd sequence before the data, so a reader that sees any of the new data also
+    // sees the slot is being written.
+    std::atomic_thread_fence(std::memory_order_release);
+    sample.timestampMs.store(timestampMs, std::memory_order_relaxed);
+    sample.energyUWs.store(energyUWs, std::memory_order_relaxed);
+    sample.sequence.store(sequence + 2, std::memory_order_release);
+    mHead.store(head + 1, std::memory_order_release);
+}
+
+void RailSampler::Ring::read(int64_t startMs, int64_t endMs,
+                             std::vector<std::pair<int64_t, int64_t>> *out) const {
+    const uint64_t capacity = kMask + 1;
+    const uint64_t head = mHead.load(std::memory_order_acquire);
+    const uint64_t first = head > capacity ? head - capacity : 0;
+    for (uint64_t i = first; i < head; i++) {
+        const Sample &sample = mSamples[i & kMask];
+        const uint64_t sequence = sample.sequence.load(std::memory_order_acquire);
+        // Slot i & kMask is written once per lap, so it holds sample i after i / capacity + 1
+        // writes. Otherwise the writer is rewriting it, or already did, for a later sample.
+        if (sequence != (i / capacity + 1) * 2) {
+            continue;
+        }
+        const int64_t timestampMs = sample.timestampMs.load(std::memory_order_relaxed);
+        const int64_t energyUWs = sample.energyUWs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sample.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+        if (timestampMs >= startMs && timestampMs <= endMs) {
+            out->push_back({timestampMs, energyUWs});
+        }
+    }
+}
+
+RailSampler::RailSampler(CoalescedEnergyMeterDataProvider *meter,
+                         const std::vector<RailConfig> &rails)
+    : mMeter(meter) {
+    const auto now = std::chrono::steady_clock::now();
+    for (const RailConfig &config : rails) {
+        const int32_t id = mMeter->getChannelId(config.name);
+        if (id < 0) {
+            LOG(ERROR) << __func__ << ": unknown channel " << config.name;
+            continue;
+        }
+        if (config.period < kMinPeriod) {
+            LOG(WARNING) << __func__ << ": sampling " << config.name << " every "
+                         << kMinPeriod.count() << " ms instead of " << config.period.count();
+        }
+        const std::chrono::milliseconds period = std::max(config.period, kMinPeriod);
+        mRails.push_back({.name = config.name,
+                          .channelId = id,
+                          .period = period,
+                          .next = now,
+                          .ring = std::make_unique<Ring>(getRingCapacity(period))});
+    }
+    if (mRails.empty()) {
+        return;
+    }
+
+    mThread = std::thread([this] {
+        pthread_setname_np(pthread_self(), "rail-sampler");
+        samplerLoop();
+    });
+}
+
+RailSampler::~RailSampler() {
+    if (!mThread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mStopping = true;
+    }
+    mCv.notify_all();
+    mThread.join();
+}
+
+bool RailSampler::parseRailConfigs(std::string_view spec, std::vector<RailConfig> *rails) {
+    for (const std::string &entry : ::android::base::Split(std::string(spec), ",")) {
+        if (entry.empty()) {
+            continue;
+        }
+        const size_t colon = entry.rfind(':');
+        uint64_t periodMs;
+        if (colon == std::string::npos || colon == 0 ||
+            !::android::base::ParseUint(entry.substr(colon + 1), &periodMs) || periodMs == 0) {
+            return false;
+        }
+        rails->push_back({.name = entry.substr(0, colon),
+                          .period = std::chrono::milliseconds(periodMs)});
+    }
+    return true;
+}
+
+void RailSampler::samplerLoop() {
+    std::vector<Rail *> due;
+    std::vector<int32_t> ids;
+    std::vector<EnergyMeasurement> measurements;
+
+    std::unique_lock<std::mutex> lock(mLock);
+    while (true) {
+        auto next = mRails.front().next;
+        for (const Rail &rail : mRails) {
+            next = std::min(next, rail.next);
+        }
+        if (mCv.wait_until(lock, next, [this] { return mStopping; })) {
+            return;
+        }
+        lock.unlock();
+
+        const auto now = std::chrono::steady_clock::now();
+        due.clear();
+        ids.clear();
+        for (Rail &rail : mRails) {
+            if (rail.next <= now) {
+                due.push_back(&rail);
+                ids.push_back(rail.channelId);
+            }
+        }
+
+        // All channels come from one read of the meter, whatever the number of rails due.
+        measurements.clear();
+        if (mMeter->readEnergyMeter(ids, &measurements, std::chrono::milliseconds(0)).isOk() &&
+            measurements.size() == due.size()) {
+            for (size_t i = 0; i < due.size(); i++) {
+                due[i]->ring->push(measurements[i].timestampMs, measurements[i].energyUWs);
+            }
+        }
+
+        for (Rail *rail : due) {
+            rail->next += rail->period;
+            // Skip the samples missed while the meter was slow instead of bursting to catch up.
+            if (rail->next <= now) {
+                rail->next = now + rail->period;
+            }
+        }
+        lock.lock();
+    }
+}
+
+bool RailSampler::getPower(const std::string &name, int64_t startMs, int64_t endMs,
+                           PowerWindow *window) {
+    const auto rail = std::find_if(mRails.begin(), mRails.end(),
+                                   [&](const Rail &r) { return r.name == name; });
+    if (rail == mRails.end()) {
+        return false;
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> samples;
+    rail->ring->read(startMs, endMs, &samples);
+    if (samples.size() < 2) {
+        return false;
+    }
+
+    // Energy is in uWs and time in ms, so uWs / ms * 1000 is uW.
+    int64_t energyUWs = 0;
+    int64_t durationMs = 0;
+    int64_t peakUW = 0;
+    for (size_t i = 1; i < samples.size(); i++) {
+        const int64_t dt = samples[i].first - samples[i - 1].first;
+        const int64_t de = samples[i].second - samples[i - 1].second;
+        // Meter resets show up as energy going backwards.
+        if (dt <= 0 || de < 0) {
+            continue;
+        }
+        energyUWs += de;
+        durationMs += dt;
+        peakUW = std::max(peakUW, de * 1000 / dt);
+    }
+
+    window->startMs = samples.front().first;
+    window->endMs = samples.back().first;
+    window->numSamples = samples.size();
+    window->averageUW = durationMs > 0 ? energyUWs * 1000 / durationMs : 0;
+    window->peakUW = peakUW;
+    return true;
+}
+
+std::vector<std::string> RailSampler::getRailNames() const {
+    std::vector<std::string> names;
+    for (const Rail &rail : mRails) {
+        names.push_back(rail.name);
+    }
+    return names;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
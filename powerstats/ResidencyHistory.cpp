@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ResidencyHistory.h"
+
+#include <algorithm>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+// Deltas can be negative when a subsystem restarts and resets its counters, so they are zigzag
+// encoded before being written as varints.
+static void putVarint(int64_t value, std::vector<uint8_t> *out) {
+    uint64_t v = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    while (v >= 0x80) {
+        out->push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(v));
+}
+
+static int64_t getVarint(const std::vector<uint8_t> &in, size_t *pos) {
+    uint64_t v = 0;
+    for (int shift = 0; *pos < in.size() && shift < 64; shift += 7) {
+        uint8_t byte = in[(*pos)++];
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+ResidencyHistory::ResidencyHistory(size_t maxBytes) : kMaxBytes(maxBytes) {}
+
+void ResidencyHistory::applyRecord(const Record &record, Snapshot *snapshot) {
+    size_t pos = 0;
+    int32_t entityId = 0;
+    while (pos < record.deltas.size()) {
+        entityId += getVarint(record.deltas, &pos);
+        int32_t stateId = getVarint(record.deltas, &pos);
+        Values &v = (*snapshot)[{entityId, stateId}];
+        v.totalTimeInStateMs += getVarint(record.deltas, &pos);
+        v.totalStateEntryCount += getVarint(record.deltas, &pos);
+        v.lastEntryTimestampMs += getVarint(record.deltas, &pos);
+    }
+}
+
+void ResidencyHistory::record(int64_t timestampMs,
+                              const std::vector<StateResidencyResult> &results) {
+    std::lock_guard<std::mutex> lock(mLock);
+    Record record = {.timestampMs = timestampMs};
+    int32_t prevEntityId = 0;
+
+    for (const auto &result : results) {
+        for (const auto &sr : result.stateResidencyData) {
+            Values &prev = mLatest[{result.id, sr.id}];
+            const Values cur = {.totalTimeInStateMs = sr.totalTimeInStateMs,
+                                .totalStateEntryCount = sr.totalStateEntryCount,
+                                .lastEntryTimestampMs = sr.lastEntryTimestampMs};
+            if (cur.totalTimeInStateMs == prev.totalTimeInStateMs &&
+                cur.totalStateEntryCount == prev.totalStateEntryCount &&
+                cur.lastEntryTimestampMs == prev.lastEntryTimestampMs) {
+                continue;
+            }
+
+            putVarint(result.id - prevEntityId, &record.deltas);
+            putVarint(sr.id, &record.deltas);
+            putVarint(cur.totalTimeInStateMs - prev.totalTimeInStateMs, &record.deltas);
+            putVarint(cur.totalStateEntryCount - prev.totalStateEntryCount, &record.deltas);
+            putVarint(cur.lastEntryTimestampMs - prev.lastEntryTimestampMs, &record.deltas);
+            prevEntityId = result.id;
+            prev = cur;
+        }
+    }
+
+    if (record.deltas.empty()) {
+        return;
+    }
+    record.deltas.shrink_to_fit();
+    mEncodedBytes += record.deltas.size();
+    mRecords.push_back(std::move(record));
+    evictLocked();
+}
+
+void ResidencyHistory::evictLocked() {
+    while (mEncodedBytes > kMaxBytes && !mRecords.empty()) {
+        const Record &oldest = mRecords.front();
+        applyRecord(oldest, &mBase);
+        mBaseTimestampMs = oldest.timestampMs;
+        mEncodedBytes -= oldest.deltas.size();
+        mRecords.pop_front();
+    }
+}
+
+int64_t ResidencyHistory::getResidencySince(int64_t sinceMs,
+                                            std::vector<StateResidencyResult> *results) {
+    std::lock_guard<std::mutex> lock(mLock);
+    Snapshot then = mBase;
+    int64_t answeredMs = std::max(sinceMs, mBaseTimestampMs);
+    for (const Record &record : mRecords) {
+        if (record.timestampMs > sinceMs) {
+            break;
+        }
+        applyRecord(record, &then);
+    }
+
+    for (const auto &[key, cur] : mLatest) {
+        const auto it = then.find(key);
+        const Values prev = (it == then.end()) ? Values() : it->second;
+        if (cur.totalTimeInStateMs == prev.totalTimeInStateMs &&
+            cur.totalStateEntryCount == prev.totalStateEntryCount &&
+            cur.lastEntryTimestampMs == prev.lastEntryTimestampMs) {
+            continue;
+        }
+
+        const auto &[entityId, stateId] = key;
+        if (results->empty() || results->back().id != entityId) {
+            results->push_back({.id = entityId});
+        }
+        results->back().stateResidencyData.push_back(
+                {.id = stateId,
+                 .totalTimeInStateMs = cur.totalTimeInStateMs - prev.totalTimeInStateMs,
+                 .totalStateEntryCount = cur.totalStateEntryCount - prev.totalStateEntryCount,
+                 .lastEntryTimestampMs = cur.lastEntryTimestampMs});
+    }
+    return answeredMs;
+}
+
+size_t ResidencyHistory::getNumRecords() {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mRecords.size();
+}
+
+size_t ResidencyHistory::getEncodedBytes() {
+    std::lock_guard<std::mutex> lock(mLock);
+    return mEncodedBytes;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StateCoefficientCalibrator.h"
+
+#include "DecimalScanner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+// Intervals needed per unknown before a fit is attempted.
+static constexpr size_t kSamplesPerUnknown = 2;
+
+static std::string_view nextToken(std::string_view s, size_t *pos) {
+    while (*pos < s.size() && (s[*pos] == ' ' || s[*pos] == '\t')) {
+        (*pos)++;
+    }
+    const size_t begin = *pos;
+    while (*pos < s.size() && s[*pos] != ' ' && s[*pos] != '\t') {
+        (*pos)++;
+    }
+    return s.substr(begin, *pos - begin);
+}
+
+// Solves a * x = b by Gaussian elimination with partial pivoting.
+static bool solve(std::vector<std::vector<double>> a, std::vector<double> b,
+                  std::vector<double> *x) {
+    const size_t n = b.size();
+    for (size_t col = 0; col < n; col++) {
+        size_t pivot = col;
+        for (size_t row = col + 1; row < n; row++) {
+            if (std::abs(a[row][col]) > std::abs(a[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if (std::abs(a[pivot][col]) < 1e-9) {
+            return false;
+        }
+        std::swap(a[col], a[pivot]);
+        std::swap(b[col], b[pivot]);
+        for (size_t row = col + 1; row < n; row++) {
+            const double factor = a[row][col] / a[col][col];
+            for (size_t k = col; k < n; k++) {
+                a[row][k] -= factor * a[col][k];
+            }
+            b[row] -= factor * b[col];
+        }
+    }
+    x->assign(n, 0);
+    for (size_t col = n; col-- > 0;) {
+        double sum = b[col];
+        for (size_t k = col + 1; k < n; k++) {
+            sum -= a[col][k] * (*x)[k];
+        }
+        (*x)[col] = sum / a[col][col];
+    }
+    return true;
+}
+
+bool StateCoefficientCalibrator::addSnapshot(std::string_view uidTimeInState, int64_t energyUWs,
+                                             int64_t timestampMs) {
+    size_t lineEnd = uidTimeInState.find('\n');
+    const std::string_view header = uidTimeInState.substr(0, lineEnd);
+    size_t pos = 0;
+    if (nextToken(header, &pos) != "uid:") {
+        return false;
+    }
+    std::vector<std::string> states;
+    for (std::string_view state = nextToken(header, &pos); !state.empty();
+         state = nextToken(header, &pos)) {
+        states.emplace_back(state);
+    }
+    if (states != mStates) {
+        *this = StateCoefficientCalibrator();
+        mStates = std::move(states);
+    }
+
+    std::vector<uint64_t> times(mStates.size(), 0);
+    while (lineEnd != std::string_view::npos) {
+        const size_t lineStart = lineEnd + 1;
+        lineEnd = uidTimeInState.find('\n', lineStart);
+        const std::string_view line = uidTimeInState.substr(lineStart, lineEnd - lineStart);
+        pos = 0;
+        if (nextToken(line, &pos).empty()) {
+            continue;
+        }
+        for (uint64_t &time : times) {
+            size_t len = 0;
+            const uint64_t value = parseDecimal(nextToken(line, &pos), &len);
+            if (len == 0) {
+                return false;
+            }
+            time += value;
+        }
+    }
+
+    if (mHasLast && timestampMs > mLastTimestampMs) {
+        std::vector<double> deltas(mStates.size());
+        for (size_t i = 0; i < mStates.size(); i++) {
+            // UIDs going away take their time with them, which can only be ignored.
+            deltas[i] = times[i] > mLastTimes[i] ? times[i] - mLastTimes[i] : 0;
+        }
+        mTimes.push_back(std::move(deltas));
+        mDurationsMs.push_back(timestampMs - mLastTimestampMs);
+        mEnergyUWs.push_back(energyUWs - mLastEnergyUWs);
+    }
+    mLastTimes = std::move(times);
+    mLastEnergyUWs = energyUWs;
+    mLastTimestampMs = timestampMs;
+    mHasLast = true;
+    return true;
+}
+
+bool StateCoefficientCalibrator::fit(Result *result) const {
+    // Unknowns are the states that were entered, then the idle power.
+    std::vector<size_t> observed;
+    for (size_t i = 0; i < mStates.size(); i++) {
+        if (std::any_of(mTimes.begin(), mTimes.end(),
+                        [i](const std::vector<double> &row) { return row[i] > 0; })) {
+            observed.push_back(i);
+        }
+    }
+    const size_t n = observed.size() + 1;
+    if (mEnergyUWs.size() < n * kSamplesPerUnknown) {
+        return false;
+    }
+
+    auto rowOf = [&](size_t sample) {
+        std::vector<double> row;
+        for (size_t i : observed) {
+            row.push_back(mTimes[sample][i]);
+        }
+        row.push_back(mDurationsMs[sample]);
+        return row;
+    };
+
+    // Normal equations.
+    std::vector<std::vector<double>> ata(n, std::vector<double>(n, 0));
+    std::vector<double> atb(n, 0);
+    for (size_t sample = 0; sample < mEnergyUWs.size(); sample++) {
+        const std::vector<double> row = rowOf(sample);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                ata[i][j] += row[i] * row[j];
+            }
+            atb[i] += row[i] * mEnergyUWs[sample];
+        }
+    }
+    std::vector<double> x;
+    if (!solve(ata, atb, &x)) {
+        return false;
+    }
+
+    double squaredError = 0;
+    for (size_t sample = 0; sample < mEnergyUWs.size(); sample++) {
+        const std::vector<double> row = rowOf(sample);
+        double predicted = 0;
+        for (size_t i = 0; i < n; i++) {
+            predicted += row[i] * x[i];
+        }
+        // uWs per ms is mW.
+        const double errorMw = (predicted - mEnergyUWs[sample]) / mDurationsMs[sample];
+        squaredError += errorMw * errorMw;
+    }
+
+    result->coeffs.clear();
+    for (const std::string &state : mStates) {
+        result->coeffs.emplace_back(state, std::nullopt);
+    }
+    for (size_t k = 0; k < observed.size(); k++) {
+        result->coeffs[observed[k]].second = x[k];
+    }
+    result->idleMw = x.back();
+    result->rmsErrorMw = std::sqrt(squaredError / mEnergyUWs.size());
+    result->numSamples = mEnergyUWs.size();
+    return true;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StateResidencyParser.h"
+
+#include "DecimalScanner.h"
+
+#include <android-base/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+// Returns the line starting at pos, without its trailing newline.
+static std::string_view peekLine(std::string_view buf, size_t pos) {
+    size_t end = buf.find('\n', pos);
+    if (end == std::string_view::npos) {
+        end = buf.size();
+    }
+    return buf.substr(pos, end - pos);
+}
+
+// Returns the line starting at *pos and advances *pos to the start of the next line.
+static std::string_view nextLine(std::string_view buf, size_t *pos) {
+    std::string_view line = peekLine(buf, *pos);
+    *pos = std::min(buf.size(), *pos + line.size() + 1);
+    return line;
+}
+
+static std::string_view skipBlanks(std::string_view line) {
+    size_t idx = 0;
+    while (idx < line.size() && (line[idx] == ' ' || line[idx] == '\t')) {
+        ++idx;
+    }
+    return line.substr(idx);
+}
+
+// Mirrors strtoull(): leading blanks are skipped and a missing number reads as 0.
+static uint64_t parseStat(std::string_view s) {
+    return parseDecimal(skipBlanks(s));
+}
+
+StateResidencyParser::StateResidencyParser(std::vector<PowerEntityConfig> configs)
+    : mPowerEntityConfigs(std::move(configs)) {
+    CHECK_LE(mPowerEntityConfigs.size(), kMaxEntries);
+
+    std::vector<std::string_view> entityHeaders;
+    std::map<std::array<std::string_view, NUM_FIELDS>, size_t> fieldTables;
+    for (const auto &entityConfig : mPowerEntityConfigs) {
+        const auto &stateConfigs = entityConfig.mStateResidencyConfigs;
+        CHECK_LE(stateConfigs.size(), kMaxEntries) << entityConfig.mName;
+        entityHeaders.push_back(entityConfig.mHeader);
+
+        CompiledEntity entity;
+        std::vector<std::string_view> stateHeaders;
+        for (const auto &stateConfig : stateConfigs) {
+            stateHeaders.push_back(stateConfig.header);
+
+            std::array<std::string_view, NUM_FIELDS> fields;
+            fields[ENTRY_COUNT] = stateConfig.entryCountPrefix;
+            fields[TOTAL_TIME] = stateConfig.totalTimePrefix;
+            fields[LAST_ENTRY] = stateConfig.lastEntryPrefix;
+            auto [it, inserted] = fieldTables.emplace(fields, mFieldMatchers.size());
+            if (inserted) {
+                mFieldMatchers.emplace_back(std::vector<std::string_view>(fields.begin(),
+                                                                          fields.end()));
+            }
+            entity.fieldMatchers.push_back(it->second);
+            entity.transforms.push_back({UnitTransform(stateConfig.totalTimeTransform),
+                                         UnitTransform(stateConfig.lastEntryTransform)});
+        }
+        entity.stateMatcher = PrefixMatcher(stateHeaders);
+        mEntities.push_back(std::move(entity));
+    }
+    mEntityMatcher = PrefixMatcher(entityHeaders);
+}
+
+bool StateResidencyParser::parseState(const StateResidencyConfig &stateConfig,
+                                      const PrefixMatcher &fieldMatcher,
+                                      const StateTransforms &transforms, std::string_view buf,
+                                      size_t *pos, StateResidency *data) const {
+    const bool supported[NUM_FIELDS] = {stateConfig.entryCountSupported,
+                                        stateConfig.totalTimeSupported,
+                                        stateConfig.lastEntrySupported};
+    const size_t numFields = supported[ENTRY_COUNT] + supported[TOTAL_TIME] +
+                             supported[LAST_ENTRY];
+    bool read[NUM_FIELDS] = {};
+    size_t numFieldsRead = 0;
+
+    while (numFieldsRead < numFields && *pos < buf.size()) {
+        const std::string_view line = skipBlanks(nextLine(buf, pos));
+        size_t len = 0;
+        const int32_t field = fieldMatcher.match(
+                line, [&](int32_t f) { return supported[f] && !read[f]; }, &len);
+        if (field == PrefixMatcher::kNoMatch) {
+            continue;
+        }
+
+        const uint64_t stat = parseStat(line.substr(len));
+        switch (field) {
+            case ENTRY_COUNT:
+                data->totalStateEntryCount = stat;
+                break;
+            case TOTAL_TIME:
+                data->totalTimeInStateMs = transforms.totalTime(stat);
+                break;
+            case LAST_ENTRY:
+                data->lastEntryTimestampMs = transforms.lastEntry(stat);
+                break;
+        }
+        read[field] = true;
+        ++numFieldsRead;
+    }
+
+    if (numFieldsRead != numFields) {
+        LOG(ERROR) << __func__ << ": failed to parse stats for " << stateConfig.name;
+        return false;
+    }
+    return true;
+}
+
+bool StateResidencyParser::parseEntity(size_t entityId, std::string_view buf, size_t *pos,
+                                       std::vector<StateResidency> *stateResidencies) const {
+    const auto &stateConfigs = mPowerEntityConfigs[entityId].mStateResidencyConfigs;
+    const CompiledEntity &entity = mEntities[entityId];
+    const size_t numStates = stateConfigs.size();
+    ReadSet stateRead;
+    size_t numStatesRead = 0;
+
+    while (numStatesRead < numStates && *pos < buf.size()) {
+        size_t len = 0;
+        const int32_t stateId = entity.stateMatcher.match(
+                skipBlanks(peekLine(buf, *pos)), [&](int32_t id) { return !stateRead[id]; },
+                &len);
+        if (stateId == PrefixMatcher::kNoMatch || len > 0) {
+            nextLine(buf, pos);
+        }
+        if (stateId == PrefixMatcher::kNoMatch) {
+            continue;
+        }
+
+        StateResidency &data = stateResidencies->at(stateId);
+        data.id = stateId;
+        if (!parseState(stateConfigs[stateId], mFieldMatchers[entity.fieldMatchers[stateId]],
+                        entity.transforms[stateId], buf, pos, &data)) {
+            return false;
+        }
+        stateRead[stateId] = true;
+        ++numStatesRead;
+    }
+
+    return numStatesRead == numStates;
+}
+
+bool StateResidencyParser::parse(
+        std::string_view buf,
+        std::unordered_map<std::string, std::vector<StateResidency>> *residencies) const {
+    const size_t numEntities = mPowerEntityConfigs.size();
+    ReadSet entityRead;
+    size_t numEntitiesRead = 0;
+    size_t pos = 0;
+
+    while (numEntitiesRead < numEntities && pos < buf.size()) {
+        size_t len = 0;
+        const int32_t entityId = mEntityMatcher.match(
+                skipBlanks(peekLine(buf, pos)), [&](int32_t id) { return !entityRead[id]; },
+                &len);
+        if (entityId == PrefixMatcher::kNoMatch || len > 0) {
+            nextLine(buf, &pos);
+        }
+        if (entityId == PrefixMatcher::kNoMatch) {
+            continue;
+        }
+
+        const PowerEntityConfig &entityConfig = mPowerEntityConfigs[entityId];
+        std::vector<StateResidency> stateResidencies(entityConfig.mStateResidencyConfigs.size());
+        if (!parseEntity(entityId, buf, &pos, &stateResidencies)) {
+            LOG(ERROR) << __func__ << ": failed to parse " << entityConfig.mName;
+            return false;
+        }
+        residencies->emplace(entityConfig.mName, std::move(stateResidencies));
+        entityRead[entityId] = true;
+        ++numEntitiesRead;
+    }
+
+    if (numEntitiesRead != numEntities) {
+        LOG(ERROR) << __func__ << ": found " << numEntitiesRead << " of " << numEntities
+                   << " power entities";
+        return false;
+    }
+    return true;
+}
+
+std::unordered_map<std::string, std::vector<State>> StateResidencyParser::getInfo() const {
+    std::unordered_map<std::string, std::vector<State>> ret;
+    for (const auto &entityConfig : mPowerEntityConfigs) {
+        int32_t stateId = 0;
+        std::vector<State> stateInfos;
+        for (const auto &stateConfig : entityConfig.mStateResidencyConfigs) {
+            stateInfos.push_back({.id = stateId++, .name = stateConfig.name});
+        }
+        ret.emplace(entityConfig.mName, std::move(stateInfos));
+    }
+    return ret;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Compares the UnitTransform dispatch of UnitConversion.h with calling the std::function of a
+ * StateResidencyConfig transform, on its own and inside a parse of a soc_stats sized buffer.
+ */
+
+#include <Gs201PowerEntityTables.h>
+#include <PowerEntityTable.h>
+#include <StateResidencyParser.h>
+#include <UnitConversion.h>
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+// Transforms in the form the configs used before UnitConversion.h.
+uint64_t usToMs(uint64_t a) {
+    return a / 1000;
+}
+uint64_t nsToMs(uint64_t a) {
+    return a / 1000000;
+}
+
+std::vector<uint64_t> makeValues() {
+    std::vector<uint64_t> values(1024);
+    uint64_t value = 88172394817;
+    for (uint64_t &v : values) {
+        value = value * 6364136223846793005 + 1442695040888963407;
+        v = value >> 16;
+    }
+    return values;
+}
+
+template <typename Transform>
+void transformValues(benchmark::State &state, const Transform &transform) {
+    const std::vector<uint64_t> values = makeValues();
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (uint64_t value : values) {
+            sum += transform(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+void BM_StdFunction_UsToMs(benchmark::State &state) {
+    const std::function<uint64_t(uint64_t)> fn = usToMs;
+    transformValues(state, fn);
+}
+BENCHMARK(BM_StdFunction_UsToMs);
+
+void BM_StdFunction_NsToMs(benchmark::State &state) {
+    const std::function<uint64_t(uint64_t)> fn = nsToMs;
+    transformValues(state, fn);
+}
+BENCHMARK(BM_StdFunction_NsToMs);
+
+void BM_UnitTransform_UsToMs(benchmark::State &state) {
+    const std::function<uint64_t(uint64_t)> fn = UsToMs();
+    transformValues(state, UnitTransform(fn));
+}
+BENCHMARK(BM_UnitTransform_UsToMs);
+
+void BM_UnitTransform_NsToMs(benchmark::State &state) {
+    const std::function<uint64_t(uint64_t)> fn = NsToMs();
+    transformValues(state, UnitTransform(fn));
+}
+BENCHMARK(BM_UnitTransform_NsToMs);
+
+// Cost of the fallback for a transform UnitTransform does not recognize.
+void BM_UnitTransform_Function(benchmark::State &state) {
+    const std::function<uint64_t(uint64_t)> fn = nsToMs;
+    transformValues(state, UnitTransform(fn));
+}
+BENCHMARK(BM_UnitTransform_Function);
+
+// soc_stats contents matching the gs201 SoC entities.
+std::string makeSocStats() {
+    std::string buf;
+    uint64_t value = 1000000007;
+    for (const PowerEntityTable &entity : gs201::kSocEntities) {
+        buf.append(entity.header).append("\n");
+        for (const StateTable &state : entity.states) {
+            buf.append(state.key).append("\n");
+            for (std::string_view prefix : {entity.fields->entryCountPrefix,
+                                            entity.fields->totalTimePrefix,
+                                            entity.fields->lastEntryPrefix}) {
+                value = value * 31 + 17;
+                buf.append("    ").append(prefix).append(" ");
+                buf.append(std::to_string(value % 1000000000000)).append("\n");
+            }
+        }
+    }
+    return buf;
+}
+
+void parseSocStats(benchmark::State &state, std::vector<PowerEntityConfig> configs) {
+    const StateResidencyParser parser(std::move(configs));
+    const std::string buf = makeSocStats();
+    for (auto _ : state) {
+        std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+        if (!parser.parse(buf, &residencies)) {
+            state.SkipWithError("Failed to parse soc_stats");
+            return;
+        }
+        benchmark::DoNotOptimize(residencies);
+    }
+}
+
+void BM_Parse_StdFunction(benchmark::State &state) {
+    std::vector<PowerEntityConfig> configs = buildPowerEntityConfigs(gs201::kSocEntities);
+    for (PowerEntityConfig &config : configs) {
+        for (auto &stateConfig : config.mStateResidencyConfigs) {
+            stateConfig.totalTimeTransform = nsToMs;
+            stateConfig.lastEntryTransform = nsToMs;
+        }
+    }
+    parseSocStats(state, std::move(configs));
+}
+BENCHMARK(BM_Parse_StdFunction);
+
+void BM_Parse_UnitTransform(benchmark::State &state) {
+    parseSocStats(state, buildPowerEntityConfigs(gs201::kSocEntities));
+}
+BENCHMARK(BM_Parse_UnitTransform);
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
+
+BENCHMARK_MAIN();
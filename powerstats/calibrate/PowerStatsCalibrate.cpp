@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Fits the state coefficients of the gs201 attributed energy consumers on device.
+ *
+ *   powerstats_calibrate.gs201 <gpu|tpu> [<duration s> [<interval ms>]]
+ *
+ * Samples the consumer's uid_time_in_state node and ODPM channels for the given duration while
+ * the device runs a representative workload, fits the coefficients with StateCoefficientCalibrator
+ * and prints them as a table to paste into Gs201PowerEntityTables.h. The tighter the workload
+ * sweeps the frequencies, the better the fit; states never entered keep their current value.
+ */
+
+#include <FileUtils.h>
+#include <Gs201CommonDataProviders.h>
+#include <Gs201PowerEntityTables.h>
+#include <StateCoefficientCalibrator.h>
+
+#include <android-base/parseint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using aidl::android::hardware::power::stats::AttributedConsumerTable;
+using aidl::android::hardware::power::stats::Channel;
+using aidl::android::hardware::power::stats::EnergyMeasurement;
+using aidl::android::hardware::power::stats::readFileToBuffer;
+using aidl::android::hardware::power::stats::StateCoeffTable;
+using aidl::android::hardware::power::stats::StateCoefficientCalibrator;
+namespace gs201 = aidl::android::hardware::power::stats::gs201;
+
+struct Target {
+    const char *name;
+    const AttributedConsumerTable *consumer;
+    // Name of the coefficient table in Gs201PowerEntityTables.h.
+    const char *table;
+};
+
+static const Target kTargets[] = {
+        {"gpu", &gs201::kGpuConsumer, "kGpuStateCoeffs"},
+        {"tpu", &gs201::kTpuConsumer, "kTpuStateCoeffs"},
+};
+
+static int usage(const char *argv0) {
+    fprintf(stderr, "usage: %s <gpu|tpu> [<duration s> [<interval ms>]]\n", argv0);
+    return EXIT_FAILURE;
+}
+
+static bool readEnergy(const std::shared_ptr<PowerStats> &p, const std::vector<int32_t> &ids,
+                       int64_t *energyUWs, int64_t *timestampMs) {
+    std::vector<EnergyMeasurement> measurements;
+    if (!p->readEnergyMeter(ids, &measurements).isOk() || measurements.size() != ids.size()) {
+        return false;
+    }
+    *energyUWs = 0;
+    *timestampMs = 0;
+    for (const EnergyMeasurement &m : measurements) {
+        *energyUWs += m.energyUWs;
+        *timestampMs = std::max(*timestampMs, m.timestampMs);
+    }
+    return true;
+}
+
+static void printTable(const Target &target, const StateCoefficientCalibrator::Result &result) {
+    printf("// Fitted from %zu intervals: idle %.0f mW, RMS error %.0f mW.\n", result.numSamples,
+           result.idleMw, result.rmsErrorMw);
+    printf("inline constexpr StateCoeffTable %s[] = {\n", target.table);
+    for (const auto &[state, coeff] : result.coeffs) {
+        int32_t current = -1;
+        for (const StateCoeffTable &entry : target.consumer->stateCoeffs) {
+            if (entry.state == state) {
+                current = entry.coeff;
+            }
+        }
+        if (!coeff) {
+            printf("        {\"%s\", %d},  // not entered, unchanged\n", state.c_str(), current);
+        } else if (*coeff < 0) {
+            printf("        {\"%s\", 0},  // fitted %.0f\n", state.c_str(), *coeff);
+        } else {
+            printf("        {\"%s\", %ld},  // was %d\n", state.c_str(), std::lround(*coeff),
+                   current);
+        }
+    }
+    printf("};\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+    const Target *target = nullptr;
+    for (const Target &t : kTargets) {
+        if (std::string(argv[1]) == t.name) {
+            target = &t;
+        }
+    }
+    uint64_t durationS = 600;
+    uint64_t intervalMs = 1000;
+    if (!target || (argc > 2 && !::android::base::ParseUint(argv[2], &durationS)) ||
+        (argc > 3 && !::android::base::ParseUint(argv[3], &intervalMs)) || intervalMs == 0) {
+        return usage(argv[0]);
+    }
+
+    std::shared_ptr<PowerStats> p = ndk::SharedRefBase::make<PowerStats>();
+    setEnergyMeter(p);
+    std::vector<Channel> channels;
+    p->getEnergyMeterInfo(&channels);
+    std::vector<int32_t> ids;
+    for (std::string_view name : target->consumer->channels) {
+        for (const Channel &channel : channels) {
+            if (channel.name == name) {
+                ids.push_back(channel.id);
+            }
+        }
+    }
+    if (ids.size() != target->consumer->channels.size()) {
+        fprintf(stderr, "Missing ODPM channels for %s\n", target->name);
+        return EXIT_FAILURE;
+    }
+
+    const std::string path(target->consumer->uidTimeInStatePath);
+    StateCoefficientCalibrator calibrator;
+    std::vector<char> buffer;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(durationS);
+    for (auto next = std::chrono::steady_clock::now(); next <= end;
+         next += std::chrono::milliseconds(intervalMs)) {
+        std::this_thread::sleep_until(next);
+        size_t used = 0;
+        int64_t energyUWs;
+        int64_t timestampMs;
+        if (!readFileToBuffer(path, &buffer, &used) ||
+            !readEnergy(p, ids, &energyUWs, &timestampMs) ||
+            !calibrator.addSnapshot(std::string_view(buffer.data(), used), energyUWs,
+                                    timestampMs)) {
+            fprintf(stderr, "Failed to sample %s\n", target->name);
+            continue;
+        }
+        fprintf(stderr, "\r%zu intervals", calibrator.getNumSamples());
+    }
+    fprintf(stderr, "\n");
+
+    StateCoefficientCalibrator::Result result;
+    if (!calibrator.fit(&result)) {
+        fprintf(stderr, "Not enough data to fit %s, run longer or vary the workload\n",
+                target->name);
+        return EXIT_FAILURE;
+    }
+    printTable(*target, result);
+    return EXIT_SUCCESS;
+}
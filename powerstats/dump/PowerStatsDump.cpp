@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Prints the dump of the running PowerStats service, see PowerStatsDumpFormat.h.
+ *
+ *   powerstats_dump.gs201 [--providers | --power <start boot time ms> [<end boot time ms>] |
+ *                          --binary]
+ *
+ * Works whatever PowerStats class the device service constructs, unlike dumpsys. Runs as root,
+ * system or shell, and is called by dump_power_gs201.sh for bugreports. On userdebug builds,
+ * "adb root && adb exec-out /vendor/bin/powerstats_dump.gs201 --binary > snapshot.bin" saves a
+ * snapshot for powerstats_snapshot_decoder.
+ */
+
+#include <PowerStatsDumpFormat.h>
+
+#include <android-base/file.h>
+#include <android-base/unique_fd.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using aidl::android::hardware::power::stats::kDumpMaxRequest;
+using aidl::android::hardware::power::stats::kDumpSocketName;
+
+int main(int argc, char **argv) {
+    std::string request;
+    for (int i = 1; i < argc; i++) {
+        request.append(argv[i]);
+        request.push_back('\0');
+    }
+    if (request.size() > kDumpMaxRequest) {
+        fprintf(stderr, "Arguments too long\n");
+        return EXIT_FAILURE;
+    }
+
+    android::base::unique_fd fd(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    constexpr size_t kNameLength = sizeof(kDumpSocketName) - 1;
+    memcpy(addr.sun_path + 1, kDumpSocketName, kNameLength);
+    const socklen_t addrLength = offsetof(sockaddr_un, sun_path) + 1 + kNameLength;
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr *>(&addr), addrLength) != 0) {
+        perror("Failed to connect to the PowerStats service");
+        return EXIT_FAILURE;
+    }
+    if (!android::base::WriteFully(fd, request.data(), request.size()) ||
+        shutdown(fd, SHUT_WR) != 0) {
+        perror("Failed to send request");
+        return EXIT_FAILURE;
+    }
+
+    char buffer[4096];
+    while (true) {
+        const ssize_t size = TEMP_FAILURE_RETRY(read(fd, buffer, sizeof(buffer)));
+        if (size < 0) {
+            perror("Failed to read dump");
+            return EXIT_FAILURE;
+        }
+        if (size == 0) {
+            return EXIT_SUCCESS;
+        }
+        if (!android::base::WriteFully(STDOUT_FILENO, buffer, size)) {
+            return EXIT_FAILURE;
+        }
+    }
+}
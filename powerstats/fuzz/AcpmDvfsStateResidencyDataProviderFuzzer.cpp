@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Feeds arbitrary fvp_stats contents to an AcpmDvfsStateResidencyDataProvider configured with the
+ * gs201 DVFS entities. The node is a file in a temporary directory rewritten on every input.
+ */
+
+#include <AcpmDvfsStateResidencyDataProvider.h>
+#include <Gs201PowerEntityTables.h>
+#include <PowerEntityTable.h>
+
+#include <android-base/file.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using aidl::android::hardware::power::stats::AcpmDvfsStateResidencyDataProvider;
+using aidl::android::hardware::power::stats::AcpmStatsSnapshot;
+using aidl::android::hardware::power::stats::buildDvfsConfigs;
+using aidl::android::hardware::power::stats::StateResidency;
+namespace gs201 = aidl::android::hardware::power::stats::gs201;
+
+// A constant to represent the number of nanoseconds in one millisecond
+static constexpr uint64_t kNsToMs = 1000000;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static TemporaryDir sDir;
+    static const std::string sPath = std::string(sDir.path) + "/fvp_stats";
+    static AcpmDvfsStateResidencyDataProvider sProvider(
+            std::make_shared<AcpmStatsSnapshot>(std::string(sDir.path) + "/"), kNsToMs,
+            buildDvfsConfigs(gs201::kDvfsEntities));
+
+    if (!android::base::WriteStringToFile(
+                std::string(reinterpret_cast<const char *>(data), size), sPath)) {
+        return 0;
+    }
+    // Each query rereads the node.
+    std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+    sProvider.getStateResidencies(&residencies);
+    return 0;
+}
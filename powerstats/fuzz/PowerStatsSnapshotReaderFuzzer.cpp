@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Walks arbitrary input the way powerstats_snapshot_decoder walks a snapshot: a list of sections,
+ * each a tag and a length prefixed payload, with every payload read as a list of records made of
+ * the field types of the format.
+ */
+
+#include <PowerStatsSnapshotFormat.h>
+
+#include <android-base/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+
+using aidl::android::hardware::power::stats::snapshot::Reader;
+
+static void readRecords(uint64_t tag, Reader *reader) {
+    for (uint64_t field = tag; reader->ok() && !reader->done(); field++) {
+        switch (field % 3) {
+            case 0:
+                reader->getUint();
+                break;
+            case 1:
+                reader->getInt();
+                break;
+            case 2:
+                reader->getString();
+                break;
+        }
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    Reader reader(data, size);
+    while (reader.ok() && !reader.done()) {
+        const uint64_t tag = reader.getUint();
+        Reader payload = reader.getSubReader(reader.getUint());
+        // A failed read must not let the payload run past the input.
+        CHECK(reader.ok() || payload.done());
+        readRecords(tag, &payload);
+    }
+    return 0;
+}
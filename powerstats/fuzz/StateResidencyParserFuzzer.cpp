@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Parses arbitrary buffers with parsers compiled from the gs201 power entity tables.
+ */
+
+#include <Gs201PowerEntityTables.h>
+#include <PowerEntityTable.h>
+#include <StateResidencyParser.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+using aidl::android::hardware::power::stats::buildPowerEntityConfigs;
+using aidl::android::hardware::power::stats::StateResidency;
+using aidl::android::hardware::power::stats::StateResidencyParser;
+namespace gs201 = aidl::android::hardware::power::stats::gs201;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static const StateResidencyParser sParsers[] = {
+            StateResidencyParser(buildPowerEntityConfigs(gs201::kSocEntities)),
+            StateResidencyParser(buildPowerEntityConfigs(gs201::kCpuEntities)),
+            StateResidencyParser(buildPowerEntityConfigs(gs201::kPowerDomainEntities)),
+    };
+
+    const std::string_view buf(reinterpret_cast<const char *>(data), size);
+    for (const StateResidencyParser &parser : sParsers) {
+        std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+        parser.parse(buf, &residencies);
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <AcpmStatsSnapshot.h>
+#include <DvfsStateResidencyDataProvider.h>
+#include <PowerStatsAidl.h>
+
+#include <string_view>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Equivalent of DvfsStateResidencyDataProvider and AdaptiveDvfsStateResidencyDataProvider, which
+ * parses the fvp_stats view of a shared AcpmStatsSnapshot instead of reading the node itself.
+ */
+class AcpmDvfsStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    using Config = DvfsStateResidencyDataProvider::Config;
+
+    /*
+     * snapshot - shared snapshot of the ACPM stats nodes.
+     * clockRate - divisor converting fvp_stats durations to milliseconds.
+     * cfgs - list of power entities and their states.
+     */
+    AcpmDvfsStateResidencyDataProvider(std::shared_ptr<AcpmStatsSnapshot> snapshot,
+                                       uint64_t clockRate, std::vector<Config> cfgs);
+    ~AcpmDvfsStateResidencyDataProvider() = default;
+
+    /*
+     * Builds the configs AdaptiveDvfsStateResidencyDataProvider would derive from the given
+     * (power entity, cpufreq stats directory) pairs: one state per frequency listed in
+     * time_in_state, plus "0MHz".
+     */
+    static std::vector<Config> cpufreqConfigs(
+            const std::vector<std::pair<std::string, std::string>> &cpuPolicyToPath);
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    int32_t matchEntity(std::string_view line) const;
+    int32_t matchState(std::string_view line, const Config &powerEntity) const;
+    bool parseState(std::string_view line, uint64_t *duration, uint64_t *count) const;
+    bool parse(std::string_view buf,
+               std::unordered_map<std::string, std::vector<StateResidency>> *residencies) const;
+
+    const std::shared_ptr<AcpmStatsSnapshot> mSnapshot;
+    const uint64_t mClockRate;
+    const std::vector<Config> mPowerEntities;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <AcpmStatsSnapshot.h>
+#include <PowerStatsAidl.h>
+#include <StateResidencyParser.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Equivalent of GenericStateResidencyDataProvider for the ACPM stats nodes, which parses a view
+ * of a shared AcpmStatsSnapshot instead of reading the node itself.
+ */
+class AcpmStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    using PowerEntityConfig = StateResidencyParser::PowerEntityConfig;
+
+    /*
+     * snapshot - shared snapshot of the ACPM stats nodes.
+     * node - ACPM stats node to parse.
+     * configs - list of power entities and their states, as for GenericStateResidencyDataProvider.
+     */
+    AcpmStateResidencyDataProvider(std::shared_ptr<AcpmStatsSnapshot> snapshot,
+                                   AcpmStatsSnapshot::Node node,
+                                   std::vector<PowerEntityConfig> configs);
+    ~AcpmStateResidencyDataProvider() = default;
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    const std::shared_ptr<AcpmStatsSnapshot> mSnapshot;
+    const AcpmStatsSnapshot::Node mNode;
+    const StateResidencyParser mParser;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <FileUtils.h>
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Keeps the ACPM stats nodes open and rereads them in place into one buffer shared by the
+ * providers registered on soc_stats, core_stats, pd_stats and fvp_stats, so that their queries
+ * neither reopen the nodes nor allocate a buffer per read.
+ *
+ * Each visit rereads the node visited and only that node. A query of one provider pays for its
+ * own node alone, and never sees contents read before it was made.
+ */
+class AcpmStatsSnapshot {
+  public:
+    enum Node : uint32_t {
+        SOC = 0,
+        CORE,
+        PD,
+        FVP,
+        NUM_NODES,
+    };
+
+    /*
+     * dir - path to the acpm_stats sysfs directory.
+     */
+    explicit AcpmStatsSnapshot(const std::string &dir = "/sys/devices/platform/acpm_stats/");
+    ~AcpmStatsSnapshot() = default;
+
+    /*
+     * Rereads the given node, invokes fn with its contents and returns its result. The view
+     * passed to fn is only valid for the duration of the call. Returns false without invoking fn
+     * if the node could not be read.
+     */
+    template <typename Fn>
+    bool visit(Node node, Fn &&fn) {
+        std::lock_guard<std::mutex> lock(mLock);
+        size_t used = 0;
+        if (!mFiles[node].read(&mBuffer, &used)) {
+            return false;
+        }
+        return fn(std::string_view(mBuffer.data(), used));
+    }
+
+    const std::string &getPath(Node node) const { return mFiles[node].getPath(); }
+
+  private:
+    static constexpr size_t kInitialBufferSize = 16 * 1024;
+
+    std::mutex mLock;
+    CachedFile mFiles[NUM_NODES];
+    std::vector<char> mBuffer;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Drives the timeout of a provider that waits on a remote processor, such as
+ * AocTimedStateResidencyDataProvider, from the latency it is observed to answer with. The
+ * provider starts with maxTimeout. Every few successful reads the timeout is set to twice the
+ * slowest of the recent latencies, within [minTimeout, maxTimeout]. A failed read doubles it back
+ * towards maxTimeout. The provider is recreated by factory whenever the timeout changes enough to
+ * matter, as the timeout is fixed at construction.
+ *
+ * The timeout only bounds how long a query waits on a remote that stopped answering. A read that
+ * completes is no faster for a lower timeout, and a read slower than the timeout fails, so the
+ * timeout is kept well above every latency recently seen.
+ *
+ * A provider whose read timed out may still be waiting on the remote, and recreating it would
+ * wait for that read. After a failure the timeout is therefore only raised on the next successful
+ * read, once the provider is idle.
+ */
+class AdaptiveTimeoutStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    using Factory = std::function<std::unique_ptr<PowerStats::IStateResidencyDataProvider>(
+            std::chrono::milliseconds timeout)>;
+
+    /*
+     * factory - creates the provider with the given timeout.
+     * minTimeout, maxTimeout - bounds of the timeout.
+     */
+    AdaptiveTimeoutStateResidencyDataProvider(Factory factory,
+                                              std::chrono::milliseconds minTimeout,
+                                              std::chrono::milliseconds maxTimeout);
+    ~AdaptiveTimeoutStateResidencyDataProvider() = default;
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+    std::chrono::milliseconds getTimeout();
+
+  private:
+    // Number of latencies the percentile is taken over.
+    static constexpr size_t kWindow = 32;
+
+    void setTimeoutLocked(std::chrono::milliseconds timeout);
+    std::chrono::milliseconds getTargetTimeoutLocked() const;
+
+    const Factory mFactory;
+    const std::chrono::milliseconds kMinTimeout;
+    const std::chrono::milliseconds kMaxTimeout;
+
+    std::mutex mLock;
+    std::chrono::milliseconds mTimeout;
+    std::unique_ptr<PowerStats::IStateResidencyDataProvider> mProvider;
+    std::chrono::microseconds mLatencies[kWindow];
+    size_t mNumLatencies = 0;
+    size_t mNextLatency = 0;
+    size_t mReadsSinceUpdate = 0;
+    // A read failed, the timeout is raised once one completes.
+    bool mRaisePending = false;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <ProviderTelemetry.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Moves the reads of a slow state residency data provider off the binder thread. The wrapped
+ * provider is read on a dedicated thread at startup and again right after every query, so a
+ * query returns the freshest completed sample without blocking, and the next query finds a
+ * sample that was read ahead of time. When refreshInterval is non-zero the sample is also
+ * refreshed periodically in the absence of queries.
+ *
+ * Without queries nor refreshes the sample grows arbitrarily old. When maxAge is non-zero, a
+ * query that finds no sample read within maxAge waits for the read it requests instead, like a
+ * call of the wrapped provider would, and fails if that read fails. A refreshInterval below
+ * maxAge keeps queries from ever waiting, at the cost of reading without queries.
+ *
+ * The reads of the reader thread are counted in the ProviderCounters registered under the name
+ * of the thread, along with the age of the sample each query was served from, which dumps show
+ * in the AvgAgeMs column.
+ */
+class AsyncStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    /*
+     * name - name of the reader thread, and of its counters.
+     * provider - provider to read asynchronously.
+     * refreshInterval - period of unsolicited refreshes, 0 to only refresh after queries.
+     * maxAge - age above which a sample is not served, 0 to serve samples of any age.
+     */
+    AsyncStateResidencyDataProvider(
+            const std::string &name,
+            std::unique_ptr<PowerStats::IStateResidencyDataProvider> provider,
+            std::chrono::milliseconds refreshInterval, std::chrono::milliseconds maxAge);
+    ~AsyncStateResidencyDataProvider();
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies. Without maxAge, returns false until
+     * the first sample has been read.
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    // Requires mLock.
+    bool isSampleFreshLocked() const;
+    void readerLoop();
+
+    const std::unique_ptr<PowerStats::IStateResidencyDataProvider> mProvider;
+    const std::chrono::milliseconds kRefreshInterval;
+    const std::chrono::milliseconds kMaxAge;
+    ProviderCounters *const mCounters;
+
+    std::mutex mLock;
+    // Wakes the reader thread.
+    std::condition_variable mCv;
+    // Wakes the queries waiting for a read.
+    std::condition_variable mReadCv;
+    bool mRefreshRequested = true;
+    bool mStopping = false;
+    bool mHasSample = false;
+    bool mSampleStatus = false;
+    // Completed reads, successful or not.
+    uint64_t mNumReads = 0;
+    std::chrono::steady_clock::time_point mSampleTime;
+    std::unordered_map<std::string, std::vector<StateResidency>> mSample;
+    std::thread mThread;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
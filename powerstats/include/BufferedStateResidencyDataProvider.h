@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <FileUtils.h>
+#include <PowerStatsAidl.h>
+#include <StateResidencyParser.h>
+
+#include <mutex>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Drop-in replacement for GenericStateResidencyDataProvider that keeps its node open, rereads it
+ * into a buffer reused across queries and parses it with a StateResidencyParser compiled from the
+ * configs.
+ */
+class BufferedStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    using PowerEntityConfig = StateResidencyParser::PowerEntityConfig;
+
+    /*
+     * path - path to the node to parse.
+     * configs - list of power entities and their states, as for GenericStateResidencyDataProvider.
+     */
+    BufferedStateResidencyDataProvider(std::string path, std::vector<PowerEntityConfig> configs);
+    ~BufferedStateResidencyDataProvider() = default;
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    const StateResidencyParser mParser;
+    std::mutex mLock;
+    CachedFile mFile;
+    std::vector<char> mBuffer;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
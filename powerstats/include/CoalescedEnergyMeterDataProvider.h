@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <ProviderTelemetry.h>
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Shares energy meter reads between callers. Every read samples all channels of the wrapped
+ * meter in one pass into a timestamped snapshot, and reads made within the coalescing window of
+ * that snapshot are served from it. Energy consumers built on the same meter channels, and the
+ * channels of different PMICs, are then read once per window instead of once per caller.
+ *
+ * The channel table is read once at construction and indexed by name, so consumers can resolve
+ * their channels without scanning it.
+ */
+class CoalescedEnergyMeterDataProvider : public PowerStats::IEnergyMeterDataProvider {
+  public:
+    /*
+     * meter - meter to sample.
+     * window - maximum age of a snapshot served to a caller.
+     */
+    CoalescedEnergyMeterDataProvider(
+            std::unique_ptr<PowerStats::IEnergyMeterDataProvider> meter,
+            std::chrono::milliseconds window);
+    ~CoalescedEnergyMeterDataProvider() = default;
+
+    /*
+     * See IEnergyMeterDataProvider::readEnergyMeter
+     */
+    ndk::ScopedAStatus readEnergyMeter(const std::vector<int32_t> &in_channelIds,
+                                       std::vector<EnergyMeasurement> *_aidl_return) override;
+
+    /*
+     * Same as above, but serves the read from any snapshot no older than maxAge.
+     */
+    ndk::ScopedAStatus readEnergyMeter(const std::vector<int32_t> &in_channelIds,
+                                       std::vector<EnergyMeasurement> *_aidl_return,
+                                       std::chrono::milliseconds maxAge);
+
+    /*
+     * See IEnergyMeterDataProvider::getEnergyMeterInfo
+     */
+    ndk::ScopedAStatus getEnergyMeterInfo(std::vector<Channel> *_aidl_return) override;
+
+    /*
+     * Returns the id of the channel with the given name, or -1 if there is none.
+     */
+    int32_t getChannelId(const std::string &name) const;
+
+  private:
+    ndk::ScopedAStatus sampleLocked(std::chrono::milliseconds maxAge);
+
+    const std::unique_ptr<PowerStats::IEnergyMeterDataProvider> mMeter;
+    const std::chrono::milliseconds kWindow;
+    ProviderCounters *const mCounters;
+    std::vector<Channel> mChannels;
+    std::unordered_map<std::string, int32_t> mChannelIds;
+
+    std::mutex mLock;
+    bool mHasSnapshot = false;
+    std::chrono::steady_clock::time_point mSnapshotTime;
+    std::vector<EnergyMeasurement> mSnapshot;
+    // Position of each channel id in mSnapshot, -1 for ids missing from it.
+    std::vector<int32_t> mSnapshotIndex;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * CPU clusters and cores, discovered from the cpufreq policies at startup so that per-cluster and
+ * per-core entities need no table of their own for every core layout. Paths are read through
+ * remapPath().
+ */
+class CpuTopology {
+  public:
+    struct Cluster {
+        // cpufreq policy directory, not remapped.
+        std::string policyDir;
+        std::vector<uint32_t> cpus;
+    };
+
+    // Most cores of a cluster getCoreName() can name unambiguously.
+    static constexpr size_t kMaxCoresPerCluster = 10;
+
+    /*
+     * Discovers the clusters from the policy* directories under cpufreqDir, ordered by their
+     * first CPU. Returns false if no policy could be read, or if a cluster has more than
+     * kMaxCoresPerCluster cores.
+     */
+    bool discover(const std::string &cpufreqDir = "/sys/devices/system/cpu/cpufreq");
+
+    const std::vector<Cluster> &getClusters() const { return mClusters; }
+
+    /*
+     * Names ACPM reports the clusters and cores by: CLUSTER<n>, and CORE<n><i> for the i-th core
+     * of cluster n.
+     */
+    static std::string getClusterName(size_t cluster);
+    static std::string getCoreName(size_t cluster, size_t core);
+
+  private:
+    std::vector<Cluster> mClusters;
+};
+
+/*
+ * Returns true if name appears in text as a whole word, e.g. as the header of an ACPM section.
+ */
+bool containsWord(std::string_view text, std::string_view name);
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Decimal counter parsing shared by the residency parsers. Digit runs of up to 15 digits, which
+ * covers every counter reported in practice, are located 16 bytes at a time with NEON (or SWAR on
+ * other targets) and converted with a handful of multiplies instead of one per digit. Longer runs
+ * and the last bytes of a buffer fall back to a scalar loop. Assumes a little-endian target.
+ */
+
+namespace decimal_internal {
+
+inline uint64_t load8(const char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Number of leading decimal digits in the 8 bytes at p.
+inline size_t leadingDigits8(const char *p) {
+    const uint64_t v = load8(p);
+    // A byte is a digit iff both it and itself + 6 are in 0x30-0x3f. Carries out of a byte only
+    // happen for non-digits, so they cannot hide the first non-digit.
+    const uint64_t nonDigit =
+            ((v & 0xf0f0f0f0f0f0f0f0) ^ 0x3030303030303030) |
+            (((v + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) ^ 0x3030303030303030);
+    return nonDigit ? __builtin_ctzll(nonDigit) / 8 : 8;
+}
+
+// Number of leading decimal digits in the 16 bytes at p.
+inline size_t leadingDigits16(const char *p) {
+#if defined(__aarch64__)
+    const uint8x16_t d =
+            vsubq_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(p)), vdupq_n_u8('0'));
+    const uint8x16_t isDigit = vcltq_u8(d, vdupq_n_u8(10));
+    // Narrow the byte mask to 4 bits per byte.
+    const uint64_t mask = vget_lane_u64(
+            vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(isDigit), 4)), 0);
+    return ~mask ? __builtin_ctzll(~mask) / 4 : 16;
+#else
+    const size_t n = leadingDigits8(p);
+    return n < 8 ? n : 8 + leadingDigits8(p + 8);
+#endif
+}
+
+// Value of the n (1 to 8) digits at p, with 8 bytes readable at p.
+inline uint64_t parseDigits8(const char *p, size_t n) {
+    // Borrows only propagate into the bytes past the digits, which the shift discards. Shifting
+    // turns the missing leading digits into zeros.
+    uint64_t v = (load8(p) - 0x3030303030303030) << (8 * (8 - n));
+    v = (v * 10 + (v >> 8)) & 0x00ff00ff00ff00ff;
+    v = (v * 100 + (v >> 16)) & 0x0000ffff0000ffff;
+    return (v * 10000 + (v >> 32)) & 0x00000000ffffffff;
+}
+
+inline constexpr uint64_t kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+
+}  // namespace decimal_internal
+
+/*
+ * Parses the decimal digits at the start of s like strtoull, saturating at UINT64_MAX. Returns 0
+ * if s does not start with a digit. The number of digits is stored in len if given.
+ */
+inline uint64_t parseDecimal(std::string_view s, size_t *len = nullptr) {
+    using namespace decimal_internal;
+
+    if (s.size() >= 16) {
+        const size_t n = leadingDigits16(s.data());
+        if (n < 16) {
+            if (len) {
+                *len = n;
+            }
+            if (n == 0) {
+                return 0;
+            }
+            if (n <= 8) {
+                return parseDigits8(s.data(), n);
+            }
+            return parseDigits8(s.data(), 8) * kPow10[n - 8] + parseDigits8(s.data() + 8, n - 8);
+        }
+    }
+
+    constexpr uint64_t kMax = std::numeric_limits<uint64_t>::max();
+    uint64_t value = 0;
+    size_t idx = 0;
+    for (; idx < s.size() && s[idx] >= '0' && s[idx] <= '9'; ++idx) {
+        uint64_t digit = s[idx] - '0';
+        value = (value > (kMax - digit) / 10) ? kMax : value * 10 + digit;
+    }
+    if (len) {
+        *len = idx;
+    }
+    return value;
+}
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <ProviderTelemetry.h>
+
+#include <android-base/unique_fd.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Keeps the residencies of a provider up to date in memory so that queries never read the
+ * provider. A dedicated thread rereads the provider whenever the watched node is signalled with
+ * sysfs_notify(), which it waits for with epoll. Until the node has been signalled once, or if it
+ * cannot be watched at all, the provider is sampled at an adaptive interval instead: halved
+ * whenever a sample differs from the previous one and doubled up to maxInterval whenever it does
+ * not. Once notifications have been seen the provider is still resampled every maxInterval as a
+ * safety net.
+ *
+ * The interval is never shorter than half the average interval between queries, nor than
+ * minInterval, since sampling faster than samples are served is wasted; before the first two
+ * queries it stays at maxInterval. A provider whose samples keep changing however often it is
+ * read, e.g. one counting time in an active state, gains nothing from faster sampling either:
+ * after kMaxChangedSamples changed samples in a row the interval is doubled instead of halved.
+ *
+ * If the watched node goes away, e.g. because its driver was unbound, the provider falls back to
+ * sampling and the node is reopened on every sample until it comes back.
+ *
+ * The first sample is read at construction, so queries are always served. The reads of the reader
+ * thread are counted in the ProviderCounters registered under the name of the thread.
+ */
+class EventDrivenStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    /*
+     * name - name of the reader thread, and of its counters.
+     * provider - provider to keep up to date.
+     * watchPath - sysfs node signalled when the residencies of the provider change.
+     * minInterval, maxInterval - bounds of the sampling interval.
+     */
+    EventDrivenStateResidencyDataProvider(
+            const std::string &name,
+            std::unique_ptr<PowerStats::IStateResidencyDataProvider> provider,
+            const std::string &watchPath, std::chrono::milliseconds minInterval,
+            std::chrono::milliseconds maxInterval);
+    ~EventDrivenStateResidencyDataProvider();
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    static constexpr int kMaxChangedSamples = 4;
+
+    bool watch(bool logErrors);
+    void unwatch();
+    // Returns false if the watched node could not be read.
+    bool rearm();
+    std::chrono::milliseconds getMinInterval();
+    // Returns true if the sample differs from the previous one.
+    bool sample();
+    void readerLoop();
+
+    const std::string kName;
+    const std::unique_ptr<PowerStats::IStateResidencyDataProvider> mProvider;
+    const std::string kWatchPath;
+    const std::chrono::milliseconds kMinInterval;
+    const std::chrono::milliseconds kMaxInterval;
+    ProviderCounters *const mCounters;
+    ::android::base::unique_fd mWatchFd;
+    // Cleared if the watched node turns out not to support polling.
+    bool mPollable = true;
+    ::android::base::unique_fd mEpollFd;
+    ::android::base::unique_fd mStopFd;
+
+    std::mutex mLock;
+    bool mSampleStatus = false;
+    std::unordered_map<std::string, std::vector<StateResidency>> mSample;
+    // Time of the last query and average interval between queries, 0 until there are two.
+    std::chrono::steady_clock::time_point mLastQuery;
+    std::chrono::milliseconds mQueryInterval{0};
+    std::thread mThread;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
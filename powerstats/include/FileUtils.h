@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <android-base/unique_fd.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Largest file the functions below read. Every node read by the providers is a few KB at most,
+ * and the parsers are linear in what they are given, so this bounds the time and memory a query
+ * can spend on a node that went wrong, e.g. one that never reaches EOF.
+ */
+constexpr size_t kMaxFileSize = 1024 * 1024;
+
+/*
+ * Appends the contents of the file at path to buffer, starting at *used, and advances *used past
+ * them. The buffer is grown as needed but never shrunk, so that a buffer reused across reads
+ * stops allocating once it has reached the size of the file. Files larger than kMaxFileSize fail
+ * with EFBIG and leave *used unchanged.
+ */
+bool readFileToBuffer(const std::string &path, std::vector<char> *buffer, size_t *used);
+
+/*
+ * Node kept open across reads. Each read rereads the node from offset 0 with pread, which makes
+ * sysfs regenerate its contents, and saves an open/close pair. The node is reopened when the fd
+ * stops working, e.g. because the device behind it went away and came back. Nodes that do not
+ * support pread are reopened on every read. Not thread safe.
+ */
+class CachedFile {
+  public:
+    explicit CachedFile(std::string path) : mPath(std::move(path)) {}
+
+    /*
+     * Same as readFileToBuffer().
+     */
+    bool read(std::vector<char> *buffer, size_t *used);
+
+    const std::string &getPath() const { return mPath; }
+
+  private:
+    bool open();
+
+    const std::string mPath;
+    ::android::base::unique_fd mFd;
+    bool mSeekable = true;
+};
+
+/*
+ * Sets the directory that absolute sysfs and device node paths passed to remapPath() are resolved
+ * against, so that providers can be pointed at a captured copy of those nodes. Must be called
+ * before any provider is created. The default root is "/".
+ */
+void setPathRoot(const std::string &root);
+
+/*
+ * Returns path resolved against the root set by setPathRoot(), and records it as a path read by
+ * the providers.
+ */
+std::string remapPath(const std::string &path);
+
+/*
+ * Returns every path given to remapPath() so far, before remapping.
+ */
+std::vector<std::string> getRemappedPaths();
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
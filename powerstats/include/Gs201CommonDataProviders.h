@@ -17,8 +17,10 @@
 #pragma once
 
 #include <PowerStatsAidl.h>
+#include <RailSampler.h>
 
 using aidl::android::hardware::power::stats::PowerStats;
+using aidl::android::hardware::power::stats::RailSampler;
 
 void addAoC(std::shared_ptr<PowerStats> p);
 void addCPUclusters(std::shared_ptr<PowerStats> p);
@@ -26,7 +28,12 @@ void addCamera(std::shared_ptr<PowerStats> p);
 void addDevfreq(std::shared_ptr<PowerStats> p);
 void addDvfsStats(std::shared_ptr<PowerStats> p);
 void addGNSS(std::shared_ptr<PowerStats> p);
+// p must live for the rest of the process: its energy meter is cached for the consumers and
+// read by the rail sampler thread, and its dump is served to powerstats_dump.gs201.
 void addGs201CommonDataProviders(std::shared_ptr<PowerStats> p);
+// Same as addGs201CommonDataProviders(), without the user space entities, whose provider
+// registers a vendor service, and without the dump server. For tools that exercise the providers of kernel nodes.
+void addGs201KernelDataProviders(std::shared_ptr<PowerStats> p);
 void addMobileRadio(std::shared_ptr<PowerStats> p);
 void addNFC(std::shared_ptr<PowerStats> p, const std::string& path);
 void addPCIe(std::shared_ptr<PowerStats> p);
@@ -38,3 +45,6 @@ void addUfs(std::shared_ptr<PowerStats> p);
 void addWifi(std::shared_ptr<PowerStats> p);
 void addWlan(std::shared_ptr<PowerStats> p);
 void setEnergyMeter(std::shared_ptr<PowerStats> p);
+
+// Returns the ODPM rail sampler started by setEnergyMeter(), or nullptr if none is configured.
+RailSampler *getRailSampler();
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerEntityTable.h>
+
+#include <private/android_filesystem_config.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace gs201 {
+
+/*
+ * Power entities of the gs201 SoC, shared by every device built on it.
+ */
+
+// ACPM stats are reported in nanoseconds.
+inline constexpr StateFieldsTable kLpmFields = {
+        true, "success_count:", true, "total_time_ns:", true, "last_entry_time_ns:", TimeUnit::NS};
+inline constexpr StateFieldsTable kDownFields = {
+        true, "down_count:", true, "total_down_time_ns:", true, "last_down_time_ns:", TimeUnit::NS};
+inline constexpr StateFieldsTable kReqFields = {
+        true, "req_up_count:", true, "total_req_up_time_ns:", true, "last_req_up_time_ns:",
+        TimeUnit::NS};
+inline constexpr StateFieldsTable kOnFields = {
+        true, "on_count:", true, "total_on_time_ns:", true, "last_on_time_ns:", TimeUnit::NS};
+
+// power_stats nodes of the modem, GNSS and WiFi drivers report microseconds.
+inline constexpr StateFieldsTable kUsecFields = {
+        true, "count:", true, "duration_usec:", true, "last_entry_timestamp_usec:", TimeUnit::US};
+inline constexpr StateFieldsTable kUsecNoLastEntryFields = {
+        true, "count:", true, "duration_usec:", false, "", TimeUnit::US};
+
+inline constexpr StateFieldsTable kCumulativeMsecFields = {
+        true, "Cumulative count:", true, "Cumulative duration msec:", true,
+        "Last entry timestamp msec:", TimeUnit::MS};
+
+inline constexpr StateFieldsTable kCountOnlyFields = {
+        true, "", false, "", false, "", TimeUnit::MS};
+
+inline constexpr StateTable kSocPowerStates[] = {
+        {"SICD", "SICD"},
+        {"SLEEP", "SLEEP"},
+        {"SLEEP_SLCMON", "SLEEP_SLCMON"},
+        {"SLEEP_HSI1ON", "SLEEP_HSI1ON"},
+        {"STOP", "STOP"},
+};
+inline constexpr StateTable kMifReqStates[] = {
+        {"AOC", "AOC"},
+        {"GSA", "GSA"},
+        {"TPU", "TPU"},
+};
+inline constexpr StateTable kSlcReqStates[] = {
+        {"AOC", "AOC"},
+};
+inline constexpr PowerEntityTable kSocEntities[] = {
+        {"LPM", "LPM:", &kLpmFields, kSocPowerStates},
+        {"MIF", "MIF:", &kDownFields, kSocPowerStates},
+        {"MIF-REQ", "MIF_REQ:", &kReqFields, kMifReqStates},
+        {"SLC", "SLC:", &kDownFields, kSocPowerStates},
+        {"SLC-REQ", "SLC_REQ:", &kReqFields, kSlcReqStates},
+};
+
+// CPU entities of the gs201 core layout, used when CpuTopology cannot discover it.
+inline constexpr StateTable kCpuStates[] = {
+        {"DOWN", ""},
+};
+inline constexpr PowerEntityTable kCpuEntities[] = {
+        {"CORE00", "CORE00", &kDownFields, kCpuStates},
+        {"CORE01", "CORE01", &kDownFields, kCpuStates},
+        {"CORE02", "CORE02", &kDownFields, kCpuStates},
+        {"CORE03", "CORE03", &kDownFields, kCpuStates},
+        {"CORE10", "CORE10", &kDownFields, kCpuStates},
+        {"CORE11", "CORE11", &kDownFields, kCpuStates},
+        {"CORE20", "CORE20", &kDownFields, kCpuStates},
+        {"CORE21", "CORE21", &kDownFields, kCpuStates},
+        {"CLUSTER0", "CLUSTER0", &kDownFields, kCpuStates},
+        {"CLUSTER1", "CLUSTER1", &kDownFields, kCpuStates},
+        {"CLUSTER2", "CLUSTER2", &kDownFields, kCpuStates},
+};
+
+inline constexpr StateTable kPowerDomainStates[] = {
+        {"ON", ""},
+};
+inline constexpr PowerEntityTable kPowerDomainEntities[] = {
+        {"pd-aur", "pd-aur:", &kOnFields, kPowerDomainStates},
+        {"pd-tpu", "pd-tpu:", &kOnFields, kPowerDomainStates},
+        {"pd-bo", "pd-bo:", &kOnFields, kPowerDomainStates},
+        {"pd-tnr", "pd-tnr:", &kOnFields, kPowerDomainStates},
+        {"pd-gdc", "pd-gdc:", &kOnFields, kPowerDomainStates},
+        {"pd-mcsc", "pd-mcsc:", &kOnFields, kPowerDomainStates},
+        {"pd-itp", "pd-itp:", &kOnFields, kPowerDomainStates},
+        {"pd-ipp", "pd-ipp:", &kOnFields, kPowerDomainStates},
+        {"pd-g3aa", "pd-g3aa:", &kOnFields, kPowerDomainStates},
+        {"pd-dns", "pd-dns:", &kOnFields, kPowerDomainStates},
+        {"pd-pdp", "pd-pdp:", &kOnFields, kPowerDomainStates},
+        {"pd-csis", "pd-csis:", &kOnFields, kPowerDomainStates},
+        {"pd-mfc", "pd-mfc:", &kOnFields, kPowerDomainStates},
+        {"pd-g2d", "pd-g2d:", &kOnFields, kPowerDomainStates},
+        {"pd-disp", "pd-disp:", &kOnFields, kPowerDomainStates},
+        {"pd-dpu", "pd-dpu:", &kOnFields, kPowerDomainStates},
+        {"pd-hsi0", "pd-hsi0:", &kOnFields, kPowerDomainStates},
+        {"pd-g3d", "pd-g3d:", &kOnFields, kPowerDomainStates},
+        {"pd-embedded_g3d", "pd-embedded_g3d:", &kOnFields, kPowerDomainStates},
+        {"pd-eh", "pd-eh:", &kOnFields, kPowerDomainStates},
+};
+
+// cpufreq stats directory of each CPU cluster, used when CpuTopology cannot discover them.
+inline constexpr StateTable kCpufreqPolicies[] = {
+        {"CL0", "/sys/devices/system/cpu/cpufreq/policy0/stats"},
+        {"CL1", "/sys/devices/system/cpu/cpufreq/policy4/stats"},
+        {"CL2", "/sys/devices/system/cpu/cpufreq/policy6/stats"},
+};
+inline constexpr StateTable kTpuFrequencies[] = {
+        {"1066MHz", "1066000"},
+        {"845MHz", "845000"},
+        {"627MHz", "627000"},
+        {"401MHz", "401000"},
+        {"226MHz", "226000"},
+        {"0MHz", "0"},
+};
+inline constexpr StateTable kAurFrequencies[] = {
+        {"1160MHz", "1160000"},
+        {"750MHz", "750000"},
+        {"373MHz", "373000"},
+        {"178MHz", "178000"},
+        {"0MHz", "0"},
+};
+inline constexpr DvfsEntityTable kDvfsEntities[] = {
+        {"TPU", kTpuFrequencies},
+        {"AUR", kAurFrequencies},
+};
+
+// devfreq directory of each power entity.
+inline constexpr StateTable kDevfreqEntities[] = {
+        {"MIF", "/sys/devices/platform/17000010.devfreq_mif/devfreq/17000010.devfreq_mif"},
+        {"INT", "/sys/devices/platform/17000020.devfreq_int/devfreq/17000020.devfreq_int"},
+        {"INTCAM",
+         "/sys/devices/platform/17000030.devfreq_intcam/devfreq/17000030.devfreq_intcam"},
+        {"DISP", "/sys/devices/platform/17000040.devfreq_disp/devfreq/17000040.devfreq_disp"},
+        {"CAM", "/sys/devices/platform/17000050.devfreq_cam/devfreq/17000050.devfreq_cam"},
+        {"TNR", "/sys/devices/platform/17000060.devfreq_tnr/devfreq/17000060.devfreq_tnr"},
+        {"MFC", "/sys/devices/platform/17000070.devfreq_mfc/devfreq/17000070.devfreq_mfc"},
+        {"BO", "/sys/devices/platform/17000080.devfreq_bo/devfreq/17000080.devfreq_bo"},
+};
+
+// Energy consumers attributed to UIDs. powerstats_calibrate.gs201 fits these coefficients.
+// TODO (b/197721618): Measuring the GPU power numbers
+inline constexpr StateCoeffTable kGpuStateCoeffs[] = {
+        {"202000", 890},
+        {"251000", 1102},
+        {"302000", 1308},
+        {"351000", 1522},
+        {"400000", 1772},
+        {"471000", 2105},
+        {"510000", 2292},
+        {"572000", 2528},
+        {"701000", 3127},
+        {"762000", 3452},
+        {"848000", 4044},
+};
+inline constexpr std::string_view kGpuChannels[] = {"S8S_VDD_G3D_L2", "S2S_VDD_G3D"};
+inline constexpr AttributedConsumerTable kGpuConsumer = {
+        "GPU", kGpuChannels, "/sys/devices/platform/28000000.mali/uid_time_in_state",
+        kGpuStateCoeffs};
+
+// TODO (b/197721618): Measuring the TPU power numbers
+inline constexpr StateCoeffTable kTpuStateCoeffs[] = {
+        {"226000", 10},
+        {"627000", 20},
+        {"845000", 30},
+        {"1066000", 40},
+};
+inline constexpr std::string_view kTpuChannels[] = {"S10M_VDD_TPU"};
+inline constexpr AttributedConsumerTable kTpuConsumer = {
+        "TPU", kTpuChannels, "/sys/class/edgetpu/edgetpu-soc/device/tpu_usage", kTpuStateCoeffs};
+
+// AoC entities and states, keyed by the prefix of their attributes in the AoC control directory.
+inline constexpr StateTable kAocCores[] = {
+        {"AoC-A32", "a32_"},
+        {"AoC-FF1", "ff1_"},
+        {"AoC-HF1", "hf1_"},
+        {"AoC-HF0", "hf0_"},
+};
+inline constexpr StateTable kAocCoreStates[] = {
+        {"DWN", "off"},
+        {"RET", "retention"},
+        {"WFI", "wfi"},
+};
+inline constexpr StateTable kAocVoltage[] = {
+        {"AoC-Voltage", "voltage_"},
+};
+inline constexpr StateTable kAocVoltageStates[] = {
+        {"NOM", "nominal"},
+        {"SUD", "super_underdrive"},
+        {"UUD", "ultra_underdrive"},
+        {"UD", "underdrive"},
+};
+inline constexpr StateTable kAocMonitor[] = {
+        {"AoC", "monitor_"},
+};
+inline constexpr StateTable kAocMonitorStates[] = {
+        {"MON", "mode"},
+};
+
+inline constexpr StateTable kAocRestartStates[] = {
+        {"RESTART", ""},
+};
+inline constexpr PowerEntityTable kAocRestartEntities[] = {
+        {"AoC-Count", "", &kCountOnlyFields, kAocRestartStates},
+};
+
+inline constexpr StateTable kModemStates[] = {
+        {"SLEEP", "SLEEP:"},
+};
+inline constexpr PowerEntityTable kModemEntities[] = {
+        {"MODEM", "", &kUsecFields, kModemStates},
+};
+
+inline constexpr StateTable kGnssStates[] = {
+        {"ON", "GPS_ON:"},
+        {"OFF", "GPS_OFF:"},
+};
+inline constexpr PowerEntityTable kGnssEntities[] = {
+        {"GPS", "", &kUsecFields, kGnssStates},
+};
+
+inline constexpr StateTable kPcieStates[] = {
+        {"UP", "Link up:"},
+        {"DOWN", "Link down:"},
+};
+inline constexpr PowerEntityTable kPcieModemEntities[] = {
+        {"PCIe-Modem", "Version: 1", &kCumulativeMsecFields, kPcieStates},
+};
+inline constexpr PowerEntityTable kPcieWifiEntities[] = {
+        {"PCIe-WiFi", "Version: 1", &kCumulativeMsecFields, kPcieStates},
+};
+
+inline constexpr StateTable kWifiStates[] = {
+        {"AWAKE", "AWAKE:"},
+        {"ASLEEP", "ASLEEP:"},
+};
+inline constexpr StateTable kWifiPcieStates[] = {
+        {"L0", "L0:"},
+        {"L1", "L1:"},
+        {"L1_1", "L1_1:"},
+        {"L1_2", "L1_2:"},
+        {"L2", "L2:"},
+};
+inline constexpr PowerEntityTable kWifiEntities[] = {
+        {"WIFI", "WIFI", &kUsecFields, kWifiStates},
+        {"WIFI-PCIE", "WIFI-PCIE", &kUsecNoLastEntryFields, kWifiPcieStates},
+};
+
+inline constexpr StateTable kNfcStates[] = {
+        {"IDLE", "Idle mode:"},
+        {"ACTIVE", "Active mode:"},
+        {"ACTIVE-RW", "Active Reader/Writer mode:"},
+};
+inline constexpr PowerEntityTable kNfcEntities[] = {
+        {"NFC", "NFC subsystem", &kCumulativeMsecFields, kNfcStates},
+};
+
+// Entities tracked in user space. They are served through the callbacks of the vendor service
+// unless persist.vendor.powerstats.push.entities lists them.
+inline constexpr StateTable kBluetoothStates[] = {
+        {"Idle", ""},
+        {"Active", ""},
+        {"Tx", ""},
+        {"Rx", ""},
+};
+inline constexpr UserspaceEntityTable kUserspaceEntities[] = {
+        {"Bluetooth", kBluetoothStates, AID_BLUETOOTH},
+};
+
+}  // namespace gs201
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <ResidencyHistory.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include <sys/types.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * PowerStats service for gs201 devices. Every getStateResidency result is recorded in a
+ * ResidencyHistory, so that residency accumulated since a given time can be read without the
+ * caller keeping its own copy of the previous result. Timestamps are boot time in milliseconds.
+ *
+ * A device service opts in by constructing this class, rather than PowerStats, before calling
+ * addGs201CommonDataProviders(). The services live with the device trees; none uses it yet, so
+ * everything below is unreachable until one does.
+ *
+ * The history is also available through "dumpsys android.hardware.power.stats.IPowerStats/default
+ * --since <boot time ms>", which lists only the states that changed since then.
+ *
+ * The dump ends with the call counters of every provider, see ProviderTelemetry.h. It also takes
+ * the arguments of dumpPowerStatsArgs(), like "--providers" for the counters only.
+ *
+ * When persist.vendor.powerstats.coalesce_ms is set, getStateResidency calls of every power entity
+ * are single-flight: a call made while a collection of every power entity is in flight waits for
+ * it, and a call made within the window after a collection completed is served from it. A call of
+ * some power entities only is served from a collection completed within the window if there is
+ * one, and otherwise reads those entities itself, so it never waits on the others.
+ */
+class Gs201PowerStats : public PowerStats {
+  public:
+    Gs201PowerStats();
+    /*
+     * coalesceWindow - window within which getStateResidency callers share one collection,
+     * overriding persist.vendor.powerstats.coalesce_ms. 0 collects on every call.
+     */
+    explicit Gs201PowerStats(std::chrono::milliseconds coalesceWindow);
+    ~Gs201PowerStats() = default;
+
+    /*
+     * See ResidencyHistory::getResidencySince
+     */
+    int64_t getResidencySince(int64_t sinceMs, std::vector<StateResidencyResult> *results);
+
+    ndk::ScopedAStatus getStateResidency(const std::vector<int32_t> &in_powerEntityIds,
+                                         std::vector<StateResidencyResult> *_aidl_return) override;
+    binder_status_t dump(int fd, const char **args, uint32_t numArgs) override;
+
+  private:
+    struct Collection {
+        std::chrono::steady_clock::time_point completed;
+        std::vector<StateResidencyResult> results;
+        // Index into results of each power entity id, or -1 if its provider failed.
+        std::vector<ssize_t> index;
+    };
+
+    std::vector<int32_t> getPowerEntityIds();
+    ndk::ScopedAStatus collect(const std::vector<int32_t> &in_powerEntityIds,
+                               std::vector<StateResidencyResult> *_aidl_return);
+    bool isCollectionFreshLocked() const;
+    // Returns the last collection if it completed within the window, without starting one.
+    std::shared_ptr<const Collection> getCompletedCollection();
+    // Returns a collection completed within the window, joining or starting one if needed.
+    std::shared_ptr<const Collection> getCollection();
+    void dumpResidencySince(int64_t sinceMs, std::ostringstream &oss);
+
+    ResidencyHistory mHistory;
+
+    const std::chrono::milliseconds kCoalesceWindow;
+    std::mutex mCollectionLock;
+    std::condition_variable mCollectionCv;
+    bool mCollecting = false;
+    uint64_t mGeneration = 0;
+    std::shared_ptr<const Collection> mCollection;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
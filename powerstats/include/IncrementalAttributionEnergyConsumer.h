@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <CoalescedEnergyMeterDataProvider.h>
+#include <FileUtils.h>
+#include <PowerStatsAidl.h>
+
+#include <map>
+#include <mutex>
+#include <string_view>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Energy consumer measured by meter channels and attributed to UIDs by their time in state,
+ * weighted by per-state coefficients, as read from a uid_time_in_state style node:
+ *
+ *   uid: <state0> <state1> ...
+ *   <uid>: <time0> <time1> ...
+ *
+ * The energy measured between two queries is split between the UIDs in proportion to the weighted
+ * time they spent in each state in between. Attributed energy accumulates per UID and is reported
+ * in UID order. A UID whose row is gone from the node, e.g. after its app was uninstalled, is
+ * dropped along with its attributed energy.
+ *
+ * Every query still reads the whole node and hashes every row, which is linear in the number of
+ * UIDs, but only rows whose hash differs from the previous snapshot are parsed and weighed. The
+ * parse and the multiplies, which dominate the cost of a row, therefore scale with the number of
+ * UIDs active since the previous query.
+ */
+class IncrementalAttributionEnergyConsumer : public PowerStats::IEnergyConsumer {
+  public:
+    /*
+     * meter - energy meter of the channels, owned by the PowerStats instance.
+     * type, name - identity of the consumer.
+     * channels - names of the meter channels summed into the consumer.
+     * uidTimeInStatePath - path to the uid_time_in_state style node.
+     * stateCoeffs - weight of each state, keyed by state name. Missing states weigh 0.
+     */
+    IncrementalAttributionEnergyConsumer(CoalescedEnergyMeterDataProvider *meter,
+                                         EnergyConsumerType type, std::string name,
+                                         const std::vector<std::string> &channels,
+                                         std::string uidTimeInStatePath,
+                                         std::map<std::string, int32_t> stateCoeffs);
+    ~IncrementalAttributionEnergyConsumer() = default;
+
+    std::pair<EnergyConsumerType, std::string> getInfo() override { return {kType, kName}; }
+
+    std::optional<EnergyConsumerResult> getEnergyConsumed() override;
+
+    std::string getConsumerName() override { return kName; }
+
+  private:
+    struct UidRow {
+        int32_t uid;
+        uint64_t hash;
+        // Read the row was last seen in.
+        uint64_t generation;
+        std::vector<uint64_t> times;
+    };
+
+    void updateHeader(std::string_view header);
+    int64_t updateRow(int32_t uid, std::string_view row);
+    void attribute(int64_t energyUWs, int64_t totalWeight);
+    // Drops the rows and attribution of the UIDs missing from the current read.
+    void pruneRows();
+
+    const EnergyConsumerType kType;
+    const std::string kName;
+    CoalescedEnergyMeterDataProvider *const mMeter;
+    std::vector<int32_t> mChannelIds;
+    const std::map<std::string, int32_t> kStateCoeffs;
+
+    std::mutex mLock;
+    CachedFile mFile;
+    std::vector<char> mBuffer;
+    uint64_t mHeaderHash = 0;
+    // Coefficient of each column of the node.
+    std::vector<int64_t> mCoeffs;
+    // Last snapshot of every row, sorted by UID.
+    std::vector<UidRow> mRows;
+    size_t mRowHint = 0;
+    uint64_t mGeneration = 0;
+    bool mHasBaseline = false;
+    int64_t mLastEnergyUWs = 0;
+    // Weighted time of the rows that changed in the current query.
+    std::vector<std::pair<int32_t, int64_t>> mChanged;
+    // Energy attributed so far, sorted by UID.
+    std::vector<EnergyConsumerAttribution> mAttribution;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <ProviderTelemetry.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Traces every getStateResidencies call of a provider and counts it in the ProviderCounters
+ * registered under the provider's name.
+ */
+class InstrumentedStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    /*
+     * name - name of the counters, and of the trace section.
+     * provider - provider to instrument.
+     */
+    InstrumentedStateResidencyDataProvider(
+            const std::string &name,
+            std::unique_ptr<PowerStats::IStateResidencyDataProvider> provider);
+    ~InstrumentedStateResidencyDataProvider() = default;
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    ProviderCounters *const mCounters;
+    const std::unique_ptr<PowerStats::IStateResidencyDataProvider> mProvider;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+
+#include <functional>
+#include <mutex>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Publishes the power entities of a provider without creating it. The provider, with whatever
+ * files, parsers and threads it owns, is only created by the first query. The info given at
+ * construction must match what the created provider reports.
+ */
+class LazyStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    using Factory = std::function<std::unique_ptr<PowerStats::IStateResidencyDataProvider>()>;
+
+    /*
+     * info - power entities and states of the provider created by factory.
+     * factory - creates the provider on the first query.
+     */
+    LazyStateResidencyDataProvider(std::unordered_map<std::string, std::vector<State>> info,
+                                   Factory factory);
+    ~LazyStateResidencyDataProvider() = default;
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    const std::unordered_map<std::string, std::vector<State>> mInfo;
+    std::mutex mLock;
+    Factory mFactory;
+    std::unique_ptr<PowerStats::IStateResidencyDataProvider> mProvider;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
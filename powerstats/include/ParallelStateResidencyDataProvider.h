@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Groups independent state residency data providers and reads them concurrently on a bounded
+ * pool of worker threads. Each provider is registered with PowerStats through a proxy returned by
+ * addDataProvider(), so a query only reads the providers of the power entities it asks for.
+ *
+ * Every read gets its own deadline, counted from when it was queued; a query waiting on a
+ * provider that misses its deadline gets that provider's last completed result instead, and the
+ * provider is not queued again until its outstanding read finishes. A slow provider therefore
+ * only delays, and only degrades, its own power entities.
+ *
+ * PowerStats reads the providers of a query one after the other, in registration order when the
+ * query asks for every power entity. Once a query has read a provider and then asks for the next
+ * one, the group queues the reads of all remaining providers at once, so a query for every power
+ * entity waits roughly one deadline rather than the sum of them. The result of a read queued less
+ * than two deadlines ago is served without reading again, which covers every provider of such a
+ * query and bounds how old a served result can be.
+ */
+class ParallelStateResidencyDataProvider
+    : public std::enable_shared_from_this<ParallelStateResidencyDataProvider> {
+  public:
+    /*
+     * numThreads - number of worker threads.
+     * deadline - time a query waits for a provider before falling back to its cached result.
+     */
+    ParallelStateResidencyDataProvider(size_t numThreads, std::chrono::milliseconds deadline);
+    ~ParallelStateResidencyDataProvider();
+
+    /*
+     * Adds a provider to the group and returns the proxy to register with PowerStats in its
+     * place. Providers must be registered in the order they are added. The proxy keeps the group
+     * alive, so the group must be owned by a std::shared_ptr.
+     */
+    std::unique_ptr<PowerStats::IStateResidencyDataProvider> addDataProvider(
+            std::unique_ptr<PowerStats::IStateResidencyDataProvider> p);
+
+  private:
+    struct Child {
+        std::unique_ptr<PowerStats::IStateResidencyDataProvider> provider;
+        size_t index;
+        std::vector<std::string> entities;
+        // Fields below are guarded by mLock.
+        bool inFlight = false;
+        std::chrono::steady_clock::time_point queued;
+        std::chrono::steady_clock::time_point deadline;
+        bool hasResult = false;
+        bool lastStatus = false;
+        std::unordered_map<std::string, std::vector<StateResidency>> lastResult;
+    };
+
+    class Proxy;
+
+    bool read(Child *child,
+              std::unordered_map<std::string, std::vector<StateResidency>> *residencies);
+    void queueLocked(Child *child, std::chrono::steady_clock::time_point now);
+    void workerLoop();
+
+    const std::chrono::milliseconds kDeadline;
+    std::vector<std::unique_ptr<Child>> mChildren;
+
+    std::mutex mLock;
+    // Signaled when work is queued or the pool is stopping.
+    std::condition_variable mWorkCv;
+    // Signaled when a read completes.
+    std::condition_variable mDoneCv;
+    std::deque<Child *> mQueue;
+    bool mStopping = false;
+    std::vector<std::thread> mThreads;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
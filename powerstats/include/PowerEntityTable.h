@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <DvfsStateResidencyDataProvider.h>
+#include <dataproviders/GenericStateResidencyDataProvider.h>
+
+#include <cstddef>
+#include <map>
+#include <string_view>
+
+#include <sys/types.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Declarative description of power entities. Tables are constexpr, so they live in .rodata and
+ * cost nothing until a provider is built from them. The configs the providers take are only
+ * materialized once, by the build* functions below.
+ */
+
+// Constant view of a constexpr array.
+template <typename T>
+class TableRef {
+  public:
+    constexpr TableRef() : mData(nullptr), mSize(0) {}
+    template <size_t N>
+    constexpr TableRef(const T (&data)[N]) : mData(data), mSize(N) {}
+    constexpr TableRef(const T *data, size_t size) : mData(data), mSize(size) {}
+
+    constexpr const T *begin() const { return mData; }
+    constexpr const T *end() const { return mData + mSize; }
+    constexpr size_t size() const { return mSize; }
+
+  private:
+    const T *mData;
+    size_t mSize;
+};
+
+enum class TimeUnit {
+    MS,
+    US,
+    NS,
+};
+
+/*
+ * Layout of the fields of every state of a power entity. See
+ * GenericStateResidencyDataProvider::StateResidencyConfig.
+ */
+struct StateFieldsTable {
+    bool entryCountSupported;
+    std::string_view entryCountPrefix;
+    bool totalTimeSupported;
+    std::string_view totalTimePrefix;
+    bool lastEntrySupported;
+    std::string_view lastEntryPrefix;
+    // Unit the times are reported in, converted to milliseconds.
+    TimeUnit timeUnit;
+};
+
+// A named state, or a named key such as the header or the frequency of the state.
+struct StateTable {
+    std::string_view name;
+    std::string_view key;
+};
+
+struct PowerEntityTable {
+    std::string_view name;
+    std::string_view header;
+    const StateFieldsTable *fields;
+    TableRef<StateTable> states;
+};
+
+struct DvfsEntityTable {
+    std::string_view name;
+    // Frequencies, as they appear in fvp_stats.
+    TableRef<StateTable> states;
+};
+
+// Power entity whose residency is tracked in user space.
+struct UserspaceEntityTable {
+    std::string_view name;
+    TableRef<StateTable> states;
+    // Uid of the process reporting the entity, the only one allowed to push its transitions.
+    uid_t clientUid;
+};
+
+// Weight of a state when the energy of a rail is split between UIDs by their time in state.
+struct StateCoeffTable {
+    std::string_view state;
+    int32_t coeff;
+};
+
+// Energy consumer measured on meter channels and attributed from a uid_time_in_state node.
+struct AttributedConsumerTable {
+    std::string_view name;
+    TableRef<std::string_view> channels;
+    std::string_view uidTimeInStatePath;
+    TableRef<StateCoeffTable> stateCoeffs;
+};
+
+using PowerEntityConfig = GenericStateResidencyDataProvider::PowerEntityConfig;
+
+/*
+ * Builds the GenericStateResidencyDataProvider configs of the given entities.
+ */
+std::vector<PowerEntityConfig> buildPowerEntityConfigs(TableRef<PowerEntityTable> entities);
+
+/*
+ * Builds the DvfsStateResidencyDataProvider configs of the given entities.
+ */
+std::vector<DvfsStateResidencyDataProvider::Config> buildDvfsConfigs(
+        TableRef<DvfsEntityTable> entities);
+
+/*
+ * Returns the power entities and states a GenericStateResidencyDataProvider built from the given
+ * entities reports.
+ */
+std::unordered_map<std::string, std::vector<State>> buildPowerEntityInfo(
+        TableRef<PowerEntityTable> entities);
+
+/*
+ * Returns the power entities and states reported by a provider giving every one of the given
+ * entities the same states, such as AocTimedStateResidencyDataProvider.
+ */
+std::unordered_map<std::string, std::vector<State>> buildPowerEntityInfo(
+        TableRef<StateTable> entities, TableRef<StateTable> states);
+
+/*
+ * Returns the states of the given table, with ids in table order.
+ */
+std::vector<State> buildStates(TableRef<StateTable> states);
+
+/*
+ * Returns the state coefficients of the given table, keyed by state.
+ */
+std::map<std::string, int32_t> buildStateCoeffs(TableRef<StateCoeffTable> coeffs);
+
+/*
+ * Returns the strings of the given table.
+ */
+std::vector<std::string> buildStrings(TableRef<std::string_view> table);
+
+/*
+ * Returns the (name, prefix + key) pairs of the given table.
+ */
+std::vector<std::pair<std::string, std::string>> buildPrefixedPairs(TableRef<StateTable> table,
+                                                                    const std::string &prefix);
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+/*
+ * Protocol of PowerStatsDumpServer. Only depends on the standard library so that clients can
+ * include it.
+ *
+ * A client connects a SOCK_STREAM socket to the abstract address kDumpSocketName, writes its dump
+ * arguments, each terminated by a NUL, and shuts down its writing side. The server replies with
+ * the dump as text, or with an error message, and closes the connection. Requests longer than
+ * kDumpMaxRequest are rejected.
+ */
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+constexpr char kDumpSocketName[] = "powerstats_dump";
+
+constexpr size_t kDumpMaxRequest = 1024;
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
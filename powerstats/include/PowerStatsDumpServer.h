@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <PowerStatsDumpFormat.h>
+
+#include <android-base/unique_fd.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Appends to out the dump that args ask for, for the arguments shared by every gs201 PowerStats
+ * service:
+ *   --providers: the call counters of every provider, see ProviderTelemetry.h.
+ *   --power <start boot time ms> [<end boot time ms>]: the average and peak power of the rails
+ *     sampled by getRailSampler() over that interval, see RailSampler.
+ *   --binary: a PowerStatsSnapshot of p, see PowerStatsSnapshotFormat.h.
+ * Returns false, leaving out and status untouched, if args are none of those.
+ */
+bool dumpPowerStatsArgs(PowerStats *p, const std::vector<std::string_view> &args,
+                        std::string *out, binder_status_t *status);
+
+/*
+ * Serves dumpPowerStatsArgs() of a PowerStats instance over an abstract unix socket, see
+ * PowerStatsDumpFormat.h. Unlike dumpsys, which only reaches the dump arguments of the class the
+ * device service constructs, this works whatever PowerStats class that is. No arguments dumps the
+ * provider counters.
+ *
+ * Clients are served one at a time on the server thread, and must run as root, system or shell,
+ * checked with SO_PEERCRED. Reads and writes of a client time out after kClientTimeout.
+ */
+class PowerStatsDumpServer {
+  public:
+    static constexpr std::chrono::seconds kClientTimeout{5};
+
+    /*
+     * p - instance to dump, must outlive the server.
+     * socketName - abstract address to listen on, kDumpSocketName unless testing.
+     */
+    explicit PowerStatsDumpServer(PowerStats *p, std::string socketName = kDumpSocketName)
+        : mPowerStats(p), kSocketName(std::move(socketName)) {}
+    ~PowerStatsDumpServer();
+
+    /*
+     * Starts accepting clients.
+     */
+    void start();
+
+  private:
+    void serve(::android::base::unique_fd client);
+    void serverLoop();
+
+    PowerStats *const mPowerStats;
+    const std::string kSocketName;
+    ::android::base::unique_fd mSocket;
+    ::android::base::unique_fd mEpollFd;
+    ::android::base::unique_fd mStopFd;
+    std::thread mThread;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Everything a PowerStats instance reports at one point in time.
+ */
+struct PowerStatsSnapshot {
+    int64_t bootTimeMs = 0;
+    std::vector<PowerEntity> entities;
+    std::vector<StateResidencyResult> residencies;
+    std::vector<Channel> channels;
+    std::vector<EnergyMeasurement> measurements;
+    std::vector<EnergyConsumer> consumers;
+    std::vector<EnergyConsumerResult> consumed;
+};
+
+/*
+ * Encodes snapshot in the format described in PowerStatsSnapshotFormat.h.
+ */
+std::vector<uint8_t> encodeSnapshot(const PowerStatsSnapshot &snapshot);
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Binary powerstats snapshot, as written by the "--binary" dump argument of dumpPowerStatsArgs(),
+ * see powerstats_dump.gs201. Only depends on the standard library so that host tools can include
+ * it.
+ *
+ *   snapshot := magic version:u8 bootTimeMs:int section*
+ *   section  := tag:uint length:uint payload[length]
+ *
+ * uint is an LEB128 varint, int is a zigzag encoded uint, string is length:uint followed by the
+ * bytes. Sections are optional and appear at most once each; decoders skip tags they do not know,
+ * so new sections can be added without bumping the version. The version only changes when the
+ * layout of an existing section does.
+ *
+ *   POWER_ENTITIES      count:uint (id:int name:string count:uint (id:int name:string)*)*
+ *   STATE_RESIDENCIES   count:uint (id:int count:uint (id:int time:int count:int last:int)*)*
+ *   CHANNELS            count:uint (id:int name:string subsystem:string)*
+ *   ENERGY_MEASUREMENTS count:uint (id:int timestampMs:int durationMs:int energyUWs:int)*
+ *   ENERGY_CONSUMERS    count:uint (id:int ordinal:int type:int name:string)*
+ *   ENERGY_CONSUMED     count:uint (id:int timestampMs:int energyUWs:int
+ *                                   count:uint (uid:int energyUWs:int)*)*
+ */
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace snapshot {
+
+constexpr char kMagic[4] = {'P', 'S', 'S', 'N'};
+constexpr uint8_t kVersion = 1;
+
+enum class Section : uint64_t {
+    POWER_ENTITIES = 1,
+    STATE_RESIDENCIES = 2,
+    CHANNELS = 3,
+    ENERGY_MEASUREMENTS = 4,
+    ENERGY_CONSUMERS = 5,
+    ENERGY_CONSUMED = 6,
+};
+
+inline void putUint(uint64_t value, std::vector<uint8_t> *out) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(value));
+}
+
+inline void putInt(int64_t value, std::vector<uint8_t> *out) {
+    putUint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63), out);
+}
+
+inline void putString(std::string_view value, std::vector<uint8_t> *out) {
+    putUint(value.size(), out);
+    out->insert(out->end(), value.begin(), value.end());
+}
+
+/*
+ * Bounds checked reader. Once a read fails every following read fails too, so a decoder can check
+ * ok() once per record instead of after every field.
+ */
+class Reader {
+  public:
+    Reader(const uint8_t *data, size_t size) : mData(data), mSize(size) {}
+
+    uint64_t getUint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (mPos >= mSize) {
+                break;
+            }
+            const uint8_t byte = mData[mPos++];
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        mOk = false;
+        return 0;
+    }
+
+    int64_t getInt() {
+        const uint64_t value = getUint();
+        return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    std::string getString() {
+        const uint64_t size = getUint();
+        if (!mOk || size > mSize - mPos) {
+            mOk = false;
+            return {};
+        }
+        std::string value(reinterpret_cast<const char *>(mData + mPos), size);
+        mPos += size;
+        return value;
+    }
+
+    // Returns a reader over the next size bytes and skips them.
+    Reader getSubReader(uint64_t size) {
+        if (!mOk || size > mSize - mPos) {
+            mOk = false;
+            return Reader(nullptr, 0);
+        }
+        Reader sub(mData + mPos, size);
+        mPos += size;
+        return sub;
+    }
+
+    bool ok() const { return mOk; }
+    bool done() const { return mPos >= mSize; }
+
+  private:
+    const uint8_t *const mData;
+    const size_t mSize;
+    size_t mPos = 0;
+    bool mOk = true;
+};
+
+}  // namespace snapshot
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Trie over a fixed table of prefixes, flattened into contiguous arrays at construction so that
+ * matching walks the input once and never allocates. The id of a prefix is its index in the
+ * table it was built from.
+ */
+class PrefixMatcher {
+  public:
+    static constexpr int32_t kNoMatch = -1;
+
+    PrefixMatcher() : PrefixMatcher(std::vector<std::string_view>{}) {}
+    explicit PrefixMatcher(const std::vector<std::string_view> &prefixes);
+
+    /*
+     * Returns the id of the longest prefix of s for which accept(id) holds, preferring the lowest
+     * id among identical prefixes, or kNoMatch. The matched length is stored in len if given.
+     */
+    template <typename Accept>
+    int32_t match(std::string_view s, Accept &&accept, size_t *len = nullptr) const {
+        int32_t best = kNoMatch;
+        size_t bestLen = 0;
+        uint32_t node = 0;
+        for (size_t depth = 0;; depth++) {
+            const Node &n = mNodes[node];
+            for (uint32_t i = n.firstId; i < n.firstId + n.numIds; i++) {
+                if (accept(mIds[i])) {
+                    best = mIds[i];
+                    bestLen = depth;
+                    break;
+                }
+            }
+            if (depth == s.size() || !findChild(n, s[depth], &node)) {
+                break;
+            }
+        }
+        if (len) {
+            *len = bestLen;
+        }
+        return best;
+    }
+
+    size_t size() const { return mSize; }
+
+  private:
+    struct Node {
+        uint32_t firstEdge;
+        uint32_t numEdges;
+        uint32_t firstId;
+        uint32_t numIds;
+    };
+    struct Edge {
+        char c;
+        uint32_t child;
+    };
+
+    bool findChild(const Node &n, char c, uint32_t *child) const {
+        const auto begin = mEdges.begin() + n.firstEdge;
+        const auto end = begin + n.numEdges;
+        const auto it = std::lower_bound(begin, end, c,
+                                         [](const Edge &e, char key) { return e.c < key; });
+        if (it == end || it->c != c) {
+            return false;
+        }
+        *child = it->child;
+        return true;
+    }
+
+    std::vector<Node> mNodes;
+    std::vector<Edge> mEdges;
+    std::vector<int32_t> mIds;
+    size_t mSize;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
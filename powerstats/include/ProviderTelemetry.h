@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Call counters of one provider: latency histogram, bytes read, failed calls, read and parse
+ * errors, and the age of the samples served by providers that read ahead of queries. Counters
+ * are split into cache line sized shards picked per thread and only updated with relaxed atomic
+ * adds, so concurrent providers do not contend; the shards are summed when dumped.
+ */
+class ProviderCounters {
+  public:
+    // Latency buckets are powers of two in us, the last one holds everything above 32 ms.
+    static constexpr size_t kNumLatencyBuckets = 16;
+
+    explicit ProviderCounters(std::string name) : kName(std::move(name)) {}
+
+    void record(std::chrono::nanoseconds latency, uint64_t bytesRead, uint64_t readErrors,
+                bool failed, bool parseError);
+
+    /*
+     * Records the age of a sample served from memory rather than read by the query.
+     */
+    void recordSampleAge(std::chrono::milliseconds age);
+
+    const std::string &getName() const { return kName; }
+
+    void dump(std::ostream &os) const;
+
+  private:
+    static constexpr size_t kNumShards = 8;
+
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> calls{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> bytesRead{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> readErrors{0};
+        std::atomic<uint64_t> parseErrors{0};
+        std::atomic<uint64_t> samplesServed{0};
+        std::atomic<uint64_t> totalSampleAgeMs{0};
+        std::atomic<uint64_t> latencyBuckets[kNumLatencyBuckets] = {};
+    };
+
+    const std::string kName;
+    Shard mShards[kNumShards];
+};
+
+/*
+ * Returns the counters registered under name, registering them on first use. The counters live
+ * for the rest of the process.
+ */
+ProviderCounters *getProviderCounters(const std::string &name);
+
+/*
+ * Writes one line per registered provider to os.
+ */
+void dumpProviderCounters(std::ostream &os);
+
+/*
+ * Called by the file helpers to count the bytes they read, and their read errors, against the
+ * innermost provider call in progress on this thread. Reads made outside of any call, e.g. while
+ * a provider is constructed, are not counted.
+ */
+void countBytesRead(size_t bytes);
+void countReadError();
+
+/*
+ * Traces and counts one provider call for its lifetime. Bytes read and read errors counted on
+ * this thread while the call is in progress are charged to it, and to the calls it is nested in.
+ *
+ * Only reads made by the calling thread are seen. Providers that read on threads of their own,
+ * such as AsyncStateResidencyDataProvider and EventDrivenStateResidencyDataProvider, count those
+ * reads under their own name, and the fan-out workers of ParallelStateResidencyDataProvider run
+ * the instrumented providers themselves. Reads made by other processes, e.g. by the vendor
+ * services PixelStateResidencyDataProvider calls back, are not seen at all.
+ */
+class ScopedProviderCall {
+  public:
+    explicit ScopedProviderCall(ProviderCounters *counters);
+    ~ScopedProviderCall();
+
+    ScopedProviderCall(const ScopedProviderCall &) = delete;
+    ScopedProviderCall &operator=(const ScopedProviderCall &) = delete;
+
+    /*
+     * Marks the call as failed. The failure is also counted as a parse error if the call read
+     * something and none of its reads failed; a failed call that read nothing on this thread is
+     * not classified.
+     */
+    void setFailed() { mFailed = true; }
+
+  private:
+    friend void countBytesRead(size_t bytes);
+    friend void countReadError();
+
+    ProviderCounters *const mCounters;
+    ScopedProviderCall *const mParent;
+    const std::chrono::steady_clock::time_point mStart;
+    uint64_t mBytesRead = 0;
+    uint64_t mReadErrors = 0;
+    bool mFailed = false;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
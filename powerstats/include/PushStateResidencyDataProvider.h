@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <PushStateResidencyFormat.h>
+
+#include <android-base/unique_fd.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <sys/types.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Serves power entities whose residency is tracked in user space, like
+ * PixelStateResidencyDataProvider, but the other way around. Instead of the provider calling every
+ * client back on each query, clients stream their state transitions to it, see
+ * PushStateResidencyFormat.h.
+ *
+ * A receiver thread moves the transitions into a lock-free queue, and queries fold the queue into
+ * residencies kept here. A query therefore never waits on a client, and its cost does not depend
+ * on the number of clients.
+ *
+ * Each entity accepts transitions only from clients running as its uid, checked with SO_PEERCRED.
+ * At most kMaxClients clients are connected at once.
+ */
+class PushStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    PushStateResidencyDataProvider() = default;
+    ~PushStateResidencyDataProvider();
+
+    // Clients connected beyond this are closed right away.
+    static constexpr size_t kMaxClients = 16;
+
+    /*
+     * Entities must all be added before start().
+     * clientUid - uid of the clients allowed to report the entity.
+     */
+    void addEntity(const std::string &name, const std::vector<State> &states, uid_t clientUid);
+
+    /*
+     * Starts accepting clients.
+     */
+    void start();
+
+    /*
+     * See IStateResidencyDataProvider::getStateResidencies
+     */
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() override;
+
+  private:
+    struct Transition {
+        size_t entity;
+        int32_t stateId;
+        int64_t timestampMs;
+    };
+
+    /*
+     * Single producer, single consumer ring. The receiver thread is the producer; consumers hold
+     * mLock.
+     */
+    class Queue {
+      public:
+        static constexpr size_t kCapacity = 1024;
+
+        bool push(const Transition &transition);
+        bool pop(Transition *transition);
+
+      private:
+        Transition mSlots[kCapacity];
+        std::atomic<size_t> mHead{0};
+        std::atomic<size_t> mTail{0};
+    };
+
+    struct Entity {
+        std::string name;
+        std::vector<State> states;
+        std::vector<StateResidency> residencies;
+        // Index of the current state, or -1 while it is unknown.
+        ssize_t current = -1;
+        int64_t enteredMs = 0;
+        uid_t clientUid;
+        // Clients that named the entity. Only used by the receiver thread.
+        size_t numClients = 0;
+    };
+
+    struct Client {
+        ::android::base::unique_fd fd;
+        uid_t uid;
+        // Index of the entity reported, or -1 until the client named it.
+        ssize_t entity = -1;
+    };
+
+    void enqueue(const Transition &transition);
+    // Both require mLock.
+    void drain();
+    void apply(const Transition &transition);
+
+    void acceptClients();
+    bool receive(Client *client);
+    void receiverLoop();
+
+    std::vector<Entity> mEntities;
+    std::mutex mLock;
+    Queue mQueue;
+
+    ::android::base::unique_fd mSocket;
+    ::android::base::unique_fd mEpollFd;
+    ::android::base::unique_fd mStopFd;
+    std::unordered_map<int, Client> mClients;
+    std::thread mThread;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/*
+ * Wire format of PushStateResidencyDataProvider. Only depends on the standard library so that
+ * clients can include it.
+ *
+ * A client connects a SOCK_SEQPACKET socket to the abstract address kPushSocketName. Its first
+ * message is the name of the power entity it reports, every following message is a batch of one
+ * or more PushTransitions, oldest first. Nothing is sent back. The connection is closed if the
+ * provider does not serve the entity named, if the client does not run as the uid the entity is
+ * reported by, or if it sends a malformed batch.
+ *
+ * Timestamps are boot time in milliseconds, later ones are taken as the time they are received.
+ * A transition to kPushUnknownState stops accumulating time until the next transition, and is
+ * implied when the last client of the entity disconnects.
+ */
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+constexpr char kPushSocketName[] = "powerstats_push";
+
+constexpr int32_t kPushUnknownState = -1;
+
+struct PushTransition {
+    // Id of the state entered, as reported by getPowerEntityInfo.
+    int32_t stateId;
+    int32_t reserved;
+    int64_t timestampMs;
+};
+
+static_assert(sizeof(PushTransition) == 16, "PushTransition is part of the wire format");
+
+// Largest batch a single message may carry.
+constexpr size_t kPushMaxBatch = 256;
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <CoalescedEnergyMeterDataProvider.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Samples selected energy meter channels in the background, each at its own period, so that the
+ * average and peak power of a rail can be computed over any recent interval rather than only
+ * between two reads of the cumulative energy. Each rail keeps its samples in a ring written only
+ * by the sampler thread and read without locks by queries; a ring holds about kHistory worth of
+ * samples. Timestamps are those of the meter, boot time in milliseconds.
+ */
+class RailSampler {
+  public:
+    static constexpr std::chrono::seconds kHistory{60};
+
+    struct RailConfig {
+        std::string name;
+        std::chrono::milliseconds period;
+    };
+
+    struct PowerWindow {
+        // Bounds of the samples the window was computed from.
+        int64_t startMs = 0;
+        int64_t endMs = 0;
+        size_t numSamples = 0;
+        int64_t averageUW = 0;
+        // Highest average power between two consecutive samples.
+        int64_t peakUW = 0;
+    };
+
+    /*
+     * meter - meter to sample, must outlive the sampler.
+     * rails - channels to sample. Unknown channels are skipped, periods under 100 ms are raised
+     * to 100 ms.
+     */
+    RailSampler(CoalescedEnergyMeterDataProvider *meter, const std::vector<RailConfig> &rails);
+    ~RailSampler();
+
+    /*
+     * Parses "<channel>:<period ms>,..." into rail configs. Returns false on malformed input.
+     */
+    static bool parseRailConfigs(std::string_view spec, std::vector<RailConfig> *rails);
+
+    /*
+     * Computes the power of a rail from the samples taken within [startMs, endMs]. Returns false
+     * if the rail is not sampled or fewer than two samples fall within the interval.
+     */
+    bool getPower(const std::string &name, int64_t startMs, int64_t endMs, PowerWindow *window);
+
+    /*
+     * Names of the sampled rails.
+     */
+    std::vector<std::string> getRailNames() const;
+
+  private:
+    struct Sample {
+        // Twice the number of writes to the slot, odd while one is in progress.
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<int64_t> timestampMs{0};
+        std::atomic<int64_t> energyUWs{0};
+    };
+
+    /*
+     * Single writer ring. Each slot is a seqlock: readers copy a slot and keep it only if its
+     * sequence shows it held the expected sample, untouched, for the whole copy. Reads never
+     * block the writer.
+     */
+    class Ring {
+      public:
+        explicit Ring(size_t capacity);
+
+        void push(int64_t timestampMs, int64_t energyUWs);
+        // Appends the samples within [startMs, endMs] to out, oldest first.
+        void read(int64_t startMs, int64_t endMs,
+                  std::vector<std::pair<int64_t, int64_t>> *out) const;
+
+      private:
+        const size_t kMask;
+        std::unique_ptr<Sample[]> mSamples;
+        std::atomic<uint64_t> mHead{0};
+    };
+
+    struct Rail {
+        std::string name;
+        int32_t channelId;
+        std::chrono::milliseconds period;
+        std::chrono::steady_clock::time_point next;
+        std::unique_ptr<Ring> ring;
+    };
+
+    void samplerLoop();
+
+    CoalescedEnergyMeterDataProvider *const mMeter;
+    std::vector<Rail> mRails;
+
+    std::mutex mLock;
+    std::condition_variable mCv;
+    bool mStopping = false;
+    std::thread mThread;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
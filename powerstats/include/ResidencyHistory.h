@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <aidl/android/hardware/power/stats/StateResidencyResult.h>
+
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Memory-bounded history of state residency snapshots. Each recorded snapshot is stored as a
+ * varint encoded list of the states that changed since the previous one. When the history
+ * exceeds its byte budget the oldest records are folded into a base snapshot, so the history
+ * can answer "residency accumulated since time T" for any T, clamped to the oldest record kept.
+ */
+class ResidencyHistory {
+  public:
+    /*
+     * maxBytes - budget for the encoded records.
+     */
+    explicit ResidencyHistory(size_t maxBytes);
+    ~ResidencyHistory() = default;
+
+    /*
+     * Records the residencies returned by a query made at timestampMs. Entities missing from
+     * results keep their previous values.
+     */
+    void record(int64_t timestampMs, const std::vector<StateResidencyResult> &results);
+
+    /*
+     * Returns, for every state that changed after sinceMs, the time and entry count accumulated
+     * since then. lastEntryTimestampMs holds the latest value. Returns the timestamp the query
+     * was actually answered from, which is later than sinceMs if that part of the history was
+     * already folded.
+     */
+    int64_t getResidencySince(int64_t sinceMs, std::vector<StateResidencyResult> *results);
+
+    size_t getNumRecords();
+    size_t getEncodedBytes();
+
+  private:
+    struct Values {
+        int64_t totalTimeInStateMs = 0;
+        int64_t totalStateEntryCount = 0;
+        int64_t lastEntryTimestampMs = 0;
+    };
+    // Keyed by (power entity id, state id).
+    using Snapshot = std::map<std::pair<int32_t, int32_t>, Values>;
+
+    struct Record {
+        int64_t timestampMs;
+        std::vector<uint8_t> deltas;
+    };
+
+    static void applyRecord(const Record &record, Snapshot *snapshot);
+    void evictLocked();
+
+    const size_t kMaxBytes;
+    std::mutex mLock;
+    Snapshot mBase;
+    int64_t mBaseTimestampMs = 0;
+    Snapshot mLatest;
+    std::deque<Record> mRecords;
+    size_t mEncodedBytes = 0;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
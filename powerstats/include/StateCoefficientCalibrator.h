@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Fits the per-state coefficients of an attributed energy consumer from the data it is attributed
+ * with. Each pair of consecutive snapshots gives one equation
+ *
+ *   energy delta = sum over states (time in state delta * coeff) + wall time delta * idle
+ *
+ * where the times in state are summed over every UID of a uid_time_in_state style node. The
+ * coefficients and the idle power are fitted by least squares. Coefficients are in energy per unit
+ * of the node's time, i.e. mW for nodes counting milliseconds.
+ */
+class StateCoefficientCalibrator {
+  public:
+    struct Result {
+        // In the order of the node's header. Empty for states never entered while calibrating.
+        std::vector<std::pair<std::string, std::optional<double>>> coeffs;
+        double idleMw = 0;
+        // Root mean square error of the fitted average power of each interval.
+        double rmsErrorMw = 0;
+        size_t numSamples = 0;
+    };
+
+    /*
+     * Adds a snapshot of the node, and of the energy of the consumer's channels at timestampMs.
+     * Returns false if the node could not be parsed. A node whose states changed restarts the
+     * calibration.
+     */
+    bool addSnapshot(std::string_view uidTimeInState, int64_t energyUWs, int64_t timestampMs);
+
+    /*
+     * Fits the snapshots added so far. Returns false if there are too few of them, or they do not
+     * tell the states apart.
+     */
+    bool fit(Result *result) const;
+
+    size_t getNumSamples() const { return mEnergyUWs.size(); }
+
+  private:
+    std::vector<std::string> mStates;
+    std::vector<uint64_t> mLastTimes;
+    int64_t mLastEnergyUWs = 0;
+    int64_t mLastTimestampMs = 0;
+    bool mHasLast = false;
+
+    // One row of state time deltas, and the wall time delta, per interval.
+    std::vector<std::vector<double>> mTimes;
+    std::vector<double> mDurationsMs;
+    std::vector<double> mEnergyUWs;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
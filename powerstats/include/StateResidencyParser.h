@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <PowerStatsAidl.h>
+#include <PrefixMatcher.h>
+#include <UnitConversion.h>
+#include <dataproviders/GenericStateResidencyDataProvider.h>
+
+#include <bitset>
+#include <string_view>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Parses the text format described by GenericStateResidencyDataProvider configs out of an
+ * in-memory buffer, so that the buffer can be filled by whoever owns the underlying node.
+ *
+ * Format:
+ *   PowerEntity1Header
+ *   PowerEntity1State1Header
+ *     <entryCountPrefix> <count>
+ *     <totalTimePrefix> <time>
+ *     <lastEntryPrefix> <time>
+ *   PowerEntity1State2Header
+ *   ...
+ *
+ * Headers and field prefixes are compiled into PrefixMatcher tables at construction and matched
+ * against each line after its leading blanks, so a parse is a single pass over the buffer that
+ * does not allocate per line. When several unread headers match a line the longest one wins. A
+ * non-empty header consumes the line it matches, an empty header matches in place. The pass
+ * never backtracks, so a malformed or truncated buffer costs at most one pass as well; the size of
+ * the buffer itself is bounded by kMaxFileSize when it is read with FileUtils.h.
+ *
+ * Time transforms built from the UnitConversion.h policies are applied without an indirect call.
+ */
+class StateResidencyParser {
+  public:
+    using PowerEntityConfig = GenericStateResidencyDataProvider::PowerEntityConfig;
+    using StateResidencyConfig = GenericStateResidencyDataProvider::StateResidencyConfig;
+
+    explicit StateResidencyParser(std::vector<PowerEntityConfig> configs);
+    ~StateResidencyParser() = default;
+
+    // The compiled tables point into the configs owned by the parser.
+    StateResidencyParser(const StateResidencyParser &) = delete;
+    StateResidencyParser &operator=(const StateResidencyParser &) = delete;
+
+    /*
+     * Parses every configured power entity out of buf into residencies. Returns false if any
+     * entity or state could not be found; entities parsed before the failure are still added.
+     */
+    bool parse(std::string_view buf,
+               std::unordered_map<std::string, std::vector<StateResidency>> *residencies) const;
+
+    /*
+     * See IStateResidencyDataProvider::getInfo
+     */
+    std::unordered_map<std::string, std::vector<State>> getInfo() const;
+
+  private:
+    // Upper bound on the number of power entities, and of states per power entity.
+    static constexpr size_t kMaxEntries = 256;
+    using ReadSet = std::bitset<kMaxEntries>;
+
+    enum Field : int32_t {
+        ENTRY_COUNT = 0,
+        TOTAL_TIME,
+        LAST_ENTRY,
+        NUM_FIELDS,
+    };
+
+    struct StateTransforms {
+        UnitTransform totalTime;
+        UnitTransform lastEntry;
+    };
+
+    struct CompiledEntity {
+        PrefixMatcher stateMatcher;
+        // Index into mFieldMatchers for each state.
+        std::vector<size_t> fieldMatchers;
+        std::vector<StateTransforms> transforms;
+    };
+
+    bool parseEntity(size_t entityId, std::string_view buf, size_t *pos,
+                     std::vector<StateResidency> *stateResidencies) const;
+    bool parseState(const StateResidencyConfig &stateConfig, const PrefixMatcher &fieldMatcher,
+                    const StateTransforms &transforms, std::string_view buf, size_t *pos,
+                    StateResidency *data) const;
+
+    const std::vector<PowerEntityConfig> mPowerEntityConfigs;
+    PrefixMatcher mEntityMatcher;
+    std::vector<CompiledEntity> mEntities;
+    // Field prefix tables, shared by all states using the same prefixes.
+    std::vector<PrefixMatcher> mFieldMatchers;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+
+/*
+ * Unit conversion policy dividing by a compile-time constant. Assigning one to a
+ * StateResidencyConfig transform lets StateResidencyParser recognize it and apply the division
+ * inline instead of calling through the std::function.
+ */
+template <uint64_t kDivisor>
+struct Divide {
+    static_assert(kDivisor > 0, "Divisor must be positive");
+    static constexpr uint64_t kValue = kDivisor;
+
+    constexpr uint64_t operator()(uint64_t value) const { return value / kDivisor; }
+};
+
+using Identity = Divide<1>;
+using UsToMs = Divide<1000>;
+using NsToMs = Divide<1000000>;
+
+/*
+ * Transform resolved once from a std::function. Identity, UsToMs and NsToMs policies become a
+ * switch over divisions by constants, which the compiler turns into multiplies; any other
+ * callable keeps going through the std::function.
+ */
+class UnitTransform {
+  public:
+    explicit UnitTransform(const std::function<uint64_t(uint64_t)> &fn) : mFn(&fn) {
+        if (fn.target<Identity>()) {
+            mKind = IDENTITY;
+        } else if (fn.target<UsToMs>()) {
+            mKind = US_TO_MS;
+        } else if (fn.target<NsToMs>()) {
+            mKind = NS_TO_MS;
+        } else {
+            mKind = FUNCTION;
+        }
+    }
+
+    uint64_t operator()(uint64_t value) const {
+        switch (mKind) {
+            case IDENTITY:
+                return Identity()(value);
+            case US_TO_MS:
+                return UsToMs()(value);
+            case NS_TO_MS:
+                return NsToMs()(value);
+            case FUNCTION:
+            default:
+                return (*mFn)(value);
+        }
+    }
+
+  private:
+    enum Kind {
+        IDENTITY,
+        US_TO_MS,
+        NS_TO_MS,
+        FUNCTION,
+    };
+
+    // Owned by the config the transform was resolved from.
+    const std::function<uint64_t(uint64_t)> *mFn;
+    Kind mKind;
+};
+
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
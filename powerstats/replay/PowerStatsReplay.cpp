@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Captures the nodes read by the gs201 powerstats providers, and replays captures through the
+ * same providers to measure their cost without depending on the state of the device. Only the
+ * providers of kernel nodes are created, see addGs201KernelDataProviders().
+ *
+ *   powerstats_replay.gs201 capture <dir> [<count> [<interval ms>]]
+ *       Copies every node the providers read into <dir>/0000, <dir>/0001, ...
+ *
+ *   powerstats_replay.gs201 replay <dir> [<rate hz> [<passes>]]
+ *       Points the providers at <dir>/current, a symlink moved to each capture in turn at the
+ *       given rate, and queries every power entity once per capture. Reports per entity query
+ *       latency and allocations, and the overall throughput. <passes> must be at least 1.
+ */
+
+#include <FileUtils.h>
+#include <Gs201CommonDataProviders.h>
+
+#include <android-base/file.h>
+#include <android-base/parseint.h>
+#include <android-base/stringprintf.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using aidl::android::hardware::power::stats::getRemappedPaths;
+using aidl::android::hardware::power::stats::PowerEntity;
+using aidl::android::hardware::power::stats::setPathRoot;
+using aidl::android::hardware::power::stats::StateResidencyResult;
+using ::android::base::StringPrintf;
+
+static std::atomic<uint64_t> sAllocations{0};
+
+// Instance the providers are added to. Never destroyed, see addGs201CommonDataProviders().
+static std::shared_ptr<PowerStats> sPowerStats;
+
+void *operator new(size_t size) {
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *p = malloc(size ? size : 1);
+    if (!p) {
+        abort();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+static bool makeDirs(const std::string &path) {
+    for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+        const std::string dir = path.substr(0, pos);
+        if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+            perror(dir.c_str());
+            return false;
+        }
+        if (pos == std::string::npos) {
+            return true;
+        }
+    }
+}
+
+// Copies a node, or the attributes directly under a directory, to the same path under dest.
+static size_t copyNode(const std::string &path, const std::string &dest) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+
+    std::vector<std::string> files;
+    if (S_ISDIR(st.st_mode)) {
+        std::unique_ptr<DIR, decltype(&closedir)> dir(opendir(path.c_str()), closedir);
+        if (!dir) {
+            return 0;
+        }
+        while (dirent *ent = readdir(dir.get())) {
+            if (ent->d_type == DT_REG) {
+                files.push_back(path + (path.back() == '/' ? "" : "/") + ent->d_name);
+            }
+        }
+    } else {
+        files.push_back(path);
+    }
+
+    size_t bytes = 0;
+    for (const std::string &file : files) {
+        std::string content;
+        if (!::android::base::ReadFileToString(file, &content)) {
+            continue;
+        }
+        const std::string out = dest + file;
+        if (!makeDirs(::android::base::Dirname(out)) ||
+            !::android::base::WriteStringToFile(content, out)) {
+            fprintf(stderr, "Failed to write %s\n", out.c_str());
+            continue;
+        }
+        bytes += content.size();
+    }
+    return bytes;
+}
+
+static std::string captureName(size_t index) {
+    return StringPrintf("%04zu", index);
+}
+
+static int capture(const std::string &dir, size_t count, std::chrono::milliseconds interval) {
+    // Creating the providers records the nodes they read. The user space entities read none, and
+    // their provider would register the vendor service of the running HAL.
+    sPowerStats = ndk::SharedRefBase::make<PowerStats>();
+    addGs201KernelDataProviders(sPowerStats);
+    const std::vector<std::string> paths = getRemappedPaths();
+
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+            std::this_thread::sleep_for(interval);
+        }
+        const std::string dest = dir + "/" + captureName(i);
+        size_t bytes = 0;
+        for (const std::string &path : paths) {
+            bytes += copyNode(path, dest);
+        }
+        printf("%s: %zu nodes, %zu bytes\n", dest.c_str(), paths.size(), bytes);
+    }
+    return 0;
+}
+
+static bool pointCurrentAt(const std::string &dir, const std::string &name) {
+    const std::string tmp = dir + "/current.tmp";
+    unlink(tmp.c_str());
+    if (symlink(name.c_str(), tmp.c_str()) != 0 ||
+        rename(tmp.c_str(), (dir + "/current").c_str()) != 0) {
+        perror("Failed to update current");
+        return false;
+    }
+    return true;
+}
+
+static int replay(const std::string &dir, double rateHz, size_t passes) {
+    std::vector<std::string> captures;
+    for (size_t i = 0; access((dir + "/" + captureName(i)).c_str(), F_OK) == 0; i++) {
+        captures.push_back(captureName(i));
+    }
+    if (captures.empty()) {
+        fprintf(stderr, "No captures found in %s\n", dir.c_str());
+        return EXIT_FAILURE;
+    }
+    if (!pointCurrentAt(dir, captures[0])) {
+        return EXIT_FAILURE;
+    }
+
+    setPathRoot(dir + "/current");
+    sPowerStats = ndk::SharedRefBase::make<PowerStats>();
+    addGs201KernelDataProviders(sPowerStats);
+    const std::shared_ptr<PowerStats> &p = sPowerStats;
+
+    std::vector<PowerEntity> entities;
+    p->getPowerEntityInfo(&entities);
+
+    struct Stats {
+        std::vector<double> latenciesUs;
+        uint64_t allocations = 0;
+        size_t failures = 0;
+    };
+    std::vector<Stats> stats(entities.size());
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(rateHz > 0 ? 1.0 / rateHz : 0.0));
+    double busyUs = 0;
+    size_t queries = 0;
+
+    auto next = std::chrono::steady_clock::now();
+    for (size_t pass = 0; pass < passes; pass++) {
+        for (const std::string &name : captures) {
+            std::this_thread::sleep_until(next);
+            next += period;
+            if (!pointCurrentAt(dir, name)) {
+                return EXIT_FAILURE;
+            }
+
+            for (const PowerEntity &entity : entities) {
+                std::vector<StateResidencyResult> results;
+                const uint64_t allocations = sAllocations.load(std::memory_order_relaxed);
+                const auto start = std::chrono::steady_clock::now();
+                const bool ok = p->getStateResidency({entity.id}, &results).isOk();
+                const double us = std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - start).count();
+
+                Stats &s = stats[entity.id];
+                s.latenciesUs.push_back(us);
+                s.allocations += sAllocations.load(std::memory_order_relaxed) - allocations;
+                s.failures += !ok;
+                busyUs += us;
+                queries++;
+            }
+        }
+    }
+
+    printf("%-24s %10s %10s %10s %12s %8s\n", "Entity", "p50 us", "p99 us", "max us",
+           "allocs/query", "failed");
+    for (const PowerEntity &entity : entities) {
+        Stats &s = stats[entity.id];
+        std::sort(s.latenciesUs.begin(), s.latenciesUs.end());
+        const size_t n = s.latenciesUs.size();
+        printf("%-24s %10.1f %10.1f %10.1f %12.1f %8zu\n", entity.name.c_str(),
+               s.latenciesUs[n / 2], s.latenciesUs[std::min(n - 1, n * 99 / 100)],
+               s.latenciesUs.back(), static_cast<double>(s.allocations) / n, s.failures);
+    }
+    printf("\n%zu queries, %.1f ms busy, %.0f queries/s\n", queries, busyUs / 1000,
+           queries / (busyUs / 1e6));
+    return 0;
+}
+
+static int usage(const char *argv0) {
+    fprintf(stderr,
+            "usage: %s capture <dir> [<count> [<interval ms>]]\n"
+            "       %s replay <dir> [<rate hz> [<passes>]]\n",
+            argv0, argv0);
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        return usage(argv[0]);
+    }
+    const std::string mode = argv[1];
+    const std::string dir = argv[2];
+
+    if (mode == "capture") {
+        size_t count = 1;
+        uint64_t intervalMs = 1000;
+        if ((argc > 3 && !::android::base::ParseUint(argv[3], &count)) ||
+            (argc > 4 && !::android::base::ParseUint(argv[4], &intervalMs))) {
+            return usage(argv[0]);
+        }
+        return capture(dir, count, std::chrono::milliseconds(intervalMs));
+    }
+
+    if (mode == "replay") {
+        double rateHz = 0;
+        size_t passes = 1;
+        if (argc > 3) {
+            rateHz = atof(argv[3]);
+        }
+        if (argc > 4 && (!::android::base::ParseUint(argv[4], &passes) || passes == 0)) {
+            return usage(argv[0]);
+        }
+        return replay(dir, rateHz, passes);
+    }
+
+    return usage(argv[0]);
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Decodes a binary powerstats snapshot into one line per value, for ingestion or for reading:
+ *
+ *   adb root
+ *   adb exec-out /vendor/bin/powerstats_dump.gs201 --binary > snapshot.bin
+ *   powerstats_snapshot_decoder snapshot.bin
+ *
+ * The dump socket behind powerstats_dump.gs201 only accepts root, system and shell, and the tool
+ * is only allowed to reach it as root on userdebug builds.
+ *
+ * Lines are tab separated and start with the kind of value they hold:
+ *
+ *   boot_time_ms <ms>
+ *   residency <entity> <state> <total time ms> <entry count> <last entry ms>
+ *   energy_meter <channel> <subsystem> <timestamp ms> <duration ms> <energy uWs>
+ *   energy_consumer <consumer> <type> <ordinal> <timestamp ms> <energy uWs>
+ *   energy_attribution <consumer> <uid> <energy uWs>
+ */
+
+#include <PowerStatsSnapshotFormat.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace aidl::android::hardware::power::stats::snapshot;
+
+namespace {
+
+struct Entity {
+    std::string name;
+    std::map<int64_t, std::string> states;
+};
+
+struct Consumer {
+    std::string name;
+    int64_t ordinal = 0;
+    int64_t type = 0;
+};
+
+// Section payloads, decoded once all of them are found so that names resolve in any order.
+struct Sections {
+    std::map<Section, Reader> readers;
+
+    Reader *get(Section section) {
+        auto it = readers.find(section);
+        return it == readers.end() ? nullptr : &it->second;
+    }
+};
+
+const std::string &lookup(const std::map<int64_t, std::string> &names, int64_t id,
+                          std::string *fallback) {
+    auto it = names.find(id);
+    if (it != names.end()) {
+        return it->second;
+    }
+    *fallback = std::to_string(id);
+    return *fallback;
+}
+
+bool decode(const std::vector<uint8_t> &data) {
+    if (data.size() < sizeof(kMagic) + 1 || memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        fprintf(stderr, "Not a powerstats snapshot\n");
+        return false;
+    }
+    if (data[sizeof(kMagic)] != kVersion) {
+        fprintf(stderr, "Unsupported snapshot version %u\n", data[sizeof(kMagic)]);
+        return false;
+    }
+
+    Reader reader(data.data() + sizeof(kMagic) + 1, data.size() - sizeof(kMagic) - 1);
+    const int64_t bootTimeMs = reader.getInt();
+    Sections sections;
+    while (reader.ok() && !reader.done()) {
+        const Section tag = static_cast<Section>(reader.getUint());
+        Reader payload = reader.getSubReader(reader.getUint());
+        sections.readers.emplace(tag, payload);
+    }
+    if (!reader.ok()) {
+        fprintf(stderr, "Truncated snapshot\n");
+        return false;
+    }
+    printf("boot_time_ms\t%" PRId64 "\n", bootTimeMs);
+
+    std::map<int64_t, Entity> entities;
+    if (Reader *r = sections.get(Section::POWER_ENTITIES)) {
+        for (uint64_t n = r->getUint(); r->ok() && n > 0; n--) {
+            Entity &entity = entities[r->getInt()];
+            entity.name = r->getString();
+            for (uint64_t states = r->getUint(); r->ok() && states > 0; states--) {
+                const int64_t id = r->getInt();
+                entity.states[id] = r->getString();
+            }
+        }
+    }
+    std::map<int64_t, std::string> entityNames;
+    for (const auto &[id, entity] : entities) {
+        entityNames[id] = entity.name;
+    }
+
+    std::string entityFallback, stateFallback;
+    if (Reader *r = sections.get(Section::STATE_RESIDENCIES)) {
+        for (uint64_t n = r->getUint(); r->ok() && n > 0; n--) {
+            const int64_t id = r->getInt();
+            const Entity &entity = entities[id];
+            const std::string &entityName = lookup(entityNames, id, &entityFallback);
+            for (uint64_t states = r->getUint(); r->ok() && states > 0; states--) {
+                const int64_t stateId = r->getInt();
+                const int64_t time = r->getInt();
+                const int64_t count = r->getInt();
+                const int64_t last = r->getInt();
+                if (r->ok()) {
+                    printf("residency\t%s\t%s\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\n",
+                           entityName.c_str(),
+                           lookup(entity.states, stateId, &stateFallback).c_str(), time, count,
+                           last);
+                }
+            }
+        }
+    }
+
+    std::map<int64_t, std::string> channelNames, channelSubsystems;
+    if (Reader *r = sections.get(Section::CHANNELS)) {
+        for (uint64_t n = r->getUint(); r->ok() && n > 0; n--) {
+            const int64_t id = r->getInt();
+            channelNames[id] = r->getString();
+            channelSubsystems[id] = r->getString();
+        }
+    }
+
+    std::string channelFallback, subsystemFallback;
+    if (Reader *r = sections.get(Section::ENERGY_MEASUREMENTS)) {
+        for (uint64_t n = r->getUint(); r->ok() && n > 0; n--) {
+            const int64_t id = r->getInt();
+            const int64_t timestampMs = r->getInt();
+            const int64_t durationMs = r->getInt();
+            const int64_t energyUWs = r->getInt();
+            if (r->ok()) {
+                printf("energy_meter\t%s\t%s\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\n",
+                       lookup(channelNames, id, &channelFallback).c_str(),
+                       lookup(channelSubsystems, id, &subsystemFallback).c_str(), timestampMs,
+                       durationMs, energyUWs);
+            }
+        }
+    }
+
+    std::map<int64_t, Consumer> consumers;
+    if (Reader *r = sections.get(Section::ENERGY_CONSUMERS)) {
+        for (uint64_t n = r->getUint(); r->ok() && n > 0; n--) {
+            Consumer &consumer = consumers[r->getInt()];
+            consumer.ordinal = r->getInt();
+            consumer.type = r->getInt();
+            consumer.name = r->getString();
+        }
+    }
+
+    if (Reader *r = sections.get(Section::ENERGY_CONSUMED)) {
+        for (uint64_t n = r->getUint(); r->ok() && n > 0; n--) {
+            const int64_t id = r->getInt();
+            const int64_t timestampMs = r->getInt();
+            const int64_t energyUWs = r->getInt();
+            const auto it = consumers.find(id);
+            const Consumer consumer =
+                    it != consumers.end() ? it->second : Consumer{.name = std::to_string(id)};
+            if (r->ok()) {
+                printf("energy_consumer\t%s\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\t%" PRId64
+                       "\n",
+                       consumer.name.c_str(), consumer.type, consumer.ordinal, timestampMs,
+                       energyUWs);
+            }
+            for (uint64_t uids = r->getUint(); r->ok() && uids > 0; uids--) {
+                const int64_t uid = r->getInt();
+                const int64_t uidEnergyUWs = r->getInt();
+                if (r->ok()) {
+                    printf("energy_attribution\t%s\t%" PRId64 "\t%" PRId64 "\n",
+                           consumer.name.c_str(), uid, uidEnergyUWs);
+                }
+            }
+        }
+    }
+
+    for (const auto &[tag, r] : sections.readers) {
+        if (!r.ok()) {
+            fprintf(stderr, "Section %" PRIu64 " is truncated\n", static_cast<uint64_t>(tag));
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [<snapshot>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *in = argc == 2 ? fopen(argv[1], "rb") : stdin;
+    if (!in) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    for (size_t n; (n = fread(buf, 1, sizeof(buf), in)) > 0;) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    if (in != stdin) {
+        fclose(in);
+    }
+
+    return decode(data) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <AcpmStatsSnapshot.h>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+class AcpmStatsSnapshotTest : public ::testing::Test {
+  protected:
+    void writeNode(const std::string &name, const std::string &contents) {
+        ASSERT_TRUE(::android::base::WriteStringToFile(contents, mDirPath + name));
+    }
+
+    std::string visit(AcpmStatsSnapshot::Node node) {
+        std::string contents;
+        const bool ok = mSnapshot.visit(node, [&contents](std::string_view buf) {
+            contents = buf;
+            return true;
+        });
+        return ok ? contents : "<failed>";
+    }
+
+    TemporaryDir mDir;
+    const std::string mDirPath = std::string(mDir.path) + "/";
+    AcpmStatsSnapshot mSnapshot{mDirPath};
+};
+
+TEST_F(AcpmStatsSnapshotTest, ReadsOnlyTheNodeVisited) {
+    // soc_stats, core_stats and fvp_stats are missing, pd_stats alone can still be read.
+    writeNode("pd_stats", "pd");
+    EXPECT_EQ(visit(AcpmStatsSnapshot::PD), "pd");
+    EXPECT_EQ(visit(AcpmStatsSnapshot::SOC), "<failed>");
+}
+
+TEST_F(AcpmStatsSnapshotTest, RereadsNodeOnEveryVisit) {
+    writeNode("soc_stats", "soc 1");
+    writeNode("pd_stats", "pd 1");
+    EXPECT_EQ(visit(AcpmStatsSnapshot::SOC), "soc 1");
+    EXPECT_EQ(visit(AcpmStatsSnapshot::PD), "pd 1");
+
+    // Visits right after each other, as from two queries, both see the latest contents.
+    writeNode("soc_stats", "soc 2");
+    writeNode("pd_stats", "pd 22");
+    EXPECT_EQ(visit(AcpmStatsSnapshot::PD), "pd 22");
+    EXPECT_EQ(visit(AcpmStatsSnapshot::SOC), "soc 2");
+}
+
+TEST_F(AcpmStatsSnapshotTest, FailsWithoutInvokingFnOnMissingNode) {
+    bool invoked = false;
+    EXPECT_FALSE(mSnapshot.visit(AcpmStatsSnapshot::FVP, [&invoked](std::string_view) {
+        invoked = true;
+        return true;
+    }));
+    EXPECT_FALSE(invoked);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <AdaptiveTimeoutStateResidencyDataProvider.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using namespace std::chrono_literals;
+
+// State of the remote the fake providers wait on, shared across their recreations.
+struct FakeRemote {
+    std::mutex lock;
+    std::condition_variable cv;
+    std::chrono::milliseconds latency = 1ms;
+    // While set, reads do not complete until it is cleared.
+    bool stuck = false;
+    std::atomic<int> created{0};
+};
+
+/*
+ * Same threading as AocTimedStateResidencyDataProvider: a reader thread answers each query, the
+ * query waits for it up to the timeout, and the destructor joins the reader.
+ */
+class FakeTimedProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    FakeTimedProvider(FakeRemote *remote, std::chrono::milliseconds timeout)
+        : mRemote(remote), mTimeout(timeout), mThread([this] { run(); }) {
+        mRemote->created++;
+    }
+
+    ~FakeTimedProvider() {
+        {
+            std::lock_guard<std::mutex> lock(mLock);
+            mState = TERMINATED;
+        }
+        mCv.notify_all();
+        mThread.join();
+    }
+
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override {
+        std::unique_lock<std::mutex> lock(mLock);
+        if (mState != COMPLETED) {
+            return false;
+        }
+        mState = RUN;
+        mCv.notify_all();
+        if (!mCv.wait_for(lock, mTimeout, [this] { return mState == COMPLETED; })) {
+            return false;
+        }
+        residencies->emplace("AoC", std::vector<StateResidency>{{.id = 0}});
+        return true;
+    }
+
+    std::unordered_map<std::string, std::vector<State>> getInfo() override {
+        return {{"AoC", {{.id = 0, .name = "On"}}}};
+    }
+
+  private:
+    enum Status { COMPLETED, RUN, TERMINATED };
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mLock);
+        while (true) {
+            mCv.wait(lock, [this] { return mState != COMPLETED; });
+            if (mState == TERMINATED) {
+                return;
+            }
+            lock.unlock();
+            {
+                std::unique_lock<std::mutex> remoteLock(mRemote->lock);
+                mRemote->cv.wait(remoteLock, [this] { return !mRemote->stuck; });
+                remoteLock.unlock();
+                std::this_thread::sleep_for(mRemote->latency);
+            }
+            lock.lock();
+            if (mState == RUN) {
+                mState = COMPLETED;
+            }
+            mCv.notify_all();
+        }
+    }
+
+    FakeRemote *const mRemote;
+    const std::chrono::milliseconds mTimeout;
+    std::mutex mLock;
+    std::condition_variable mCv;
+    Status mState = COMPLETED;
+    std::thread mThread;
+};
+
+class AdaptiveTimeoutStateResidencyDataProviderTest : public ::testing::Test {
+  protected:
+    bool query() {
+        std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+        return mProvider.getStateResidencies(&residencies);
+    }
+
+    void setStuck(bool stuck) {
+        {
+            std::lock_guard<std::mutex> lock(mRemote.lock);
+            mRemote.stuck = stuck;
+        }
+        mRemote.cv.notify_all();
+    }
+
+    FakeRemote mRemote;
+    AdaptiveTimeoutStateResidencyDataProvider mProvider{
+            [this](std::chrono::milliseconds timeout) {
+                return std::make_unique<FakeTimedProvider>(&mRemote, timeout);
+            },
+            10ms, 400ms};
+};
+
+TEST_F(AdaptiveTimeoutStateResidencyDataProviderTest, TimeoutCoversSlowestRecentRead) {
+    EXPECT_EQ(mProvider.getTimeout(), 400ms);
+    for (int i = 0; i < 8; i++) {
+        mRemote.latency = i == 3 ? 40ms : 2ms;
+        ASSERT_TRUE(query());
+    }
+    // Twice the slowest read rather than a percentile, which the 40ms read would have failed.
+    EXPECT_GE(mProvider.getTimeout(), 80ms);
+    EXPECT_LT(mProvider.getTimeout(), 120ms);
+    EXPECT_EQ(mRemote.created, 2);
+}
+
+TEST_F(AdaptiveTimeoutStateResidencyDataProviderTest, FailedReadDoesNotWaitForStuckRemote) {
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(query());
+    }
+    const std::chrono::milliseconds timeout = mProvider.getTimeout();
+    ASSERT_LT(timeout, 400ms);
+
+    setStuck(true);
+    std::thread release([this] {
+        std::this_thread::sleep_for(1s);
+        setStuck(false);
+    });
+
+    // The query waits for its timeout only, not for the remote to answer.
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(query());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, timeout + 200ms);
+    // The provider is still waiting on the remote, later queries fail without waiting.
+    start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(query());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 100ms);
+    EXPECT_EQ(mProvider.getTimeout(), timeout);
+    EXPECT_EQ(mRemote.created, 2);
+
+    release.join();
+    // Once the stuck read completes, the next read succeeds and only then raises the timeout.
+    std::this_thread::sleep_for(50ms);
+    EXPECT_TRUE(query());
+    EXPECT_EQ(mProvider.getTimeout(), std::min(timeout * 2, std::chrono::milliseconds(400)));
+    EXPECT_EQ(mRemote.created, 3);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
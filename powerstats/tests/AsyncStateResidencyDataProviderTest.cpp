@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <AsyncStateResidencyDataProvider.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using namespace std::chrono_literals;
+
+// One power entity whose residency is the number of reads so far, read in a given time.
+class FakeStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    explicit FakeStateResidencyDataProvider(std::chrono::milliseconds latency)
+        : mLatency(latency) {}
+
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override {
+        std::this_thread::sleep_for(mLatency);
+        const int read = ++mReads;
+        if (mFailing) {
+            return false;
+        }
+        residencies->emplace("E", std::vector<StateResidency>{{.id = 0,
+                                                               .totalTimeInStateMs = read}});
+        return true;
+    }
+
+    std::unordered_map<std::string, std::vector<State>> getInfo() override {
+        return {{"E", {{.id = 0, .name = "ON"}}}};
+    }
+
+    int getReads() const { return mReads; }
+    void setFailing(bool failing) { mFailing = failing; }
+
+  private:
+    const std::chrono::milliseconds mLatency;
+    std::atomic<int> mReads = 0;
+    std::atomic<bool> mFailing = false;
+};
+
+class AsyncStateResidencyDataProviderTest : public ::testing::Test {
+  protected:
+    void create(std::chrono::milliseconds maxAge) {
+        auto fake = std::make_unique<FakeStateResidencyDataProvider>(20ms);
+        mFake = fake.get();
+        mProvider = std::make_unique<AsyncStateResidencyDataProvider>("async-test",
+                                                                      std::move(fake), 0ms,
+                                                                      maxAge);
+    }
+
+    // Returns the residency served, or -1 if the query failed.
+    int64_t query() {
+        std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+        if (!mProvider->getStateResidencies(&residencies)) {
+            return -1;
+        }
+        return residencies.at("E").at(0).totalTimeInStateMs;
+    }
+
+    FakeStateResidencyDataProvider *mFake;
+    std::unique_ptr<AsyncStateResidencyDataProvider> mProvider;
+};
+
+TEST_F(AsyncStateResidencyDataProviderTest, UnboundedServesSampleOfAnyAge) {
+    create(0ms);
+    // The first query finds no sample yet, and the read it requests is served later on.
+    EXPECT_EQ(query(), -1);
+    std::this_thread::sleep_for(200ms);
+    const int reads = mFake->getReads();
+    const auto start = std::chrono::steady_clock::now();
+    // The sample is over 100ms old, and still served without waiting for the read requested.
+    EXPECT_EQ(query(), reads);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 10ms);
+}
+
+TEST_F(AsyncStateResidencyDataProviderTest, FirstQueryWaitsForSample) {
+    create(1s);
+    EXPECT_GT(query(), 0);
+}
+
+TEST_F(AsyncStateResidencyDataProviderTest, StaleSampleIsReadAgain) {
+    create(50ms);
+    ASSERT_GT(query(), 0);
+    // Let the read requested by the query above complete, then the sample age past maxAge.
+    std::this_thread::sleep_for(200ms);
+    const int reads = mFake->getReads();
+    const auto start = std::chrono::steady_clock::now();
+    // Served from a read that completed after the query was made.
+    EXPECT_GT(query(), reads);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 10ms);
+}
+
+TEST_F(AsyncStateResidencyDataProviderTest, FreshSampleIsServedWithoutWaiting) {
+    create(1s);
+    ASSERT_GT(query(), 0);
+    std::this_thread::sleep_for(100ms);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_GT(query(), 0);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 10ms);
+}
+
+TEST_F(AsyncStateResidencyDataProviderTest, FailsIfStaleSampleCannotBeRead) {
+    create(50ms);
+    ASSERT_GT(query(), 0);
+    std::this_thread::sleep_for(200ms);
+    mFake->setFailing(true);
+    // The previous sample is too old, and the read meant to replace it failed.
+    EXPECT_EQ(query(), -1);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <CoalescedEnergyMeterDataProvider.h>
+
+#include <android-base/file.h>
+#include <android-base/strings.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using namespace std::chrono_literals;
+
+/*
+ * Meter reading an IIO energy_value node in a temporary directory, in the format of the ODPM
+ * driver:
+ *   t=<timestamp ms>
+ *   CH<n>(T=<timestamp ms>)[<rail>], <energy uWs>
+ */
+class FakeIioEnergyMeterDataProvider : public PowerStats::IEnergyMeterDataProvider {
+  public:
+    FakeIioEnergyMeterDataProvider(std::string path, std::atomic<int> *reads)
+        : mPath(std::move(path)), mReads(reads) {}
+
+    ndk::ScopedAStatus readEnergyMeter(const std::vector<int32_t> &in_channelIds,
+                                       std::vector<EnergyMeasurement> *_aidl_return) override {
+        ++*mReads;
+        std::string content;
+        if (!::android::base::ReadFileToString(mPath, &content)) {
+            return ndk::ScopedAStatus::fromExceptionCode(EX_ILLEGAL_STATE);
+        }
+        for (const std::string &line : ::android::base::Split(content, "\n")) {
+            int32_t id;
+            int64_t timestampMs;
+            int64_t energyUWs;
+            if (sscanf(line.c_str(), "CH%" SCNd32 "(T=%" SCNd64 ")[%*[^]]], %" SCNd64, &id,
+                       &timestampMs, &energyUWs) == 3) {
+                _aidl_return->push_back(
+                        {.id = id, .timestampMs = timestampMs, .energyUWs = energyUWs});
+            }
+        }
+        return ndk::ScopedAStatus::ok();
+    }
+
+    ndk::ScopedAStatus getEnergyMeterInfo(std::vector<Channel> *_aidl_return) override {
+        *_aidl_return = {{.id = 0, .name = "S10M_VDD_TPU", .subsystem = "TPU"},
+                         {.id = 1, .name = "S2S_VDD_G3D", .subsystem = "GPU"}};
+        return ndk::ScopedAStatus::ok();
+    }
+
+  private:
+    const std::string mPath;
+    std::atomic<int> *const mReads;
+};
+
+class CoalescedEnergyMeterDataProviderTest : public ::testing::Test {
+  protected:
+    std::unique_ptr<CoalescedEnergyMeterDataProvider> makeMeter(std::chrono::milliseconds window) {
+        return std::make_unique<CoalescedEnergyMeterDataProvider>(
+                std::make_unique<FakeIioEnergyMeterDataProvider>(mPath, &mReads), window);
+    }
+
+    void writeEnergy(int64_t timestampMs, int64_t tpuUWs, int64_t gpuUWs) {
+        const std::string t = std::to_string(timestampMs);
+        ASSERT_TRUE(::android::base::WriteStringToFile(
+                "t=" + t + "\nCH0(T=" + t + ")[S10M_VDD_TPU], " + std::to_string(tpuUWs) +
+                        "\nCH1(T=" + t + ")[S2S_VDD_G3D], " + std::to_string(gpuUWs) + "\n",
+                mPath));
+    }
+
+    TemporaryDir mDir;
+    const std::string mPath = std::string(mDir.path) + "/energy_value";
+    std::atomic<int> mReads = 0;
+};
+
+TEST_F(CoalescedEnergyMeterDataProviderTest, ResolvesChannelNames) {
+    auto meter = makeMeter(0ms);
+    EXPECT_EQ(meter->getChannelId("S10M_VDD_TPU"), 0);
+    EXPECT_EQ(meter->getChannelId("S2S_VDD_G3D"), 1);
+    EXPECT_EQ(meter->getChannelId("S8S_VDD_G3D_L2"), -1);
+}
+
+TEST_F(CoalescedEnergyMeterDataProviderTest, ReadWithinWindowIsServedFromSnapshot) {
+    auto meter = makeMeter(1h);
+    writeEnergy(100, 1000, 2000);
+    std::vector<EnergyMeasurement> first;
+    ASSERT_TRUE(meter->readEnergyMeter({}, &first).isOk());
+    ASSERT_EQ(first.size(), 2);
+    EXPECT_EQ(first[0].energyUWs, 1000);
+    EXPECT_EQ(first[1].energyUWs, 2000);
+
+    writeEnergy(200, 1500, 2500);
+    std::vector<EnergyMeasurement> second;
+    ASSERT_TRUE(meter->readEnergyMeter({1}, &second).isOk());
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_EQ(second[0].id, 1);
+    EXPECT_EQ(second[0].timestampMs, 100);
+    EXPECT_EQ(second[0].energyUWs, 2000);
+    EXPECT_EQ(mReads, 1);
+}
+
+TEST_F(CoalescedEnergyMeterDataProviderTest, ReadPastMaxAgeSamplesAgain) {
+    auto meter = makeMeter(1h);
+    writeEnergy(100, 1000, 2000);
+    std::vector<EnergyMeasurement> first;
+    ASSERT_TRUE(meter->readEnergyMeter({}, &first).isOk());
+
+    writeEnergy(200, 1500, 2500);
+    std::vector<EnergyMeasurement> second;
+    ASSERT_TRUE(meter->readEnergyMeter({0}, &second, 0ms).isOk());
+    ASSERT_EQ(second.size(), 1);
+    EXPECT_EQ(second[0].timestampMs, 200);
+    EXPECT_EQ(second[0].energyUWs, 1500);
+    EXPECT_EQ(mReads, 2);
+}
+
+TEST_F(CoalescedEnergyMeterDataProviderTest, ZeroWindowSamplesEveryRead) {
+    auto meter = makeMeter(0ms);
+    for (int64_t i = 1; i <= 3; i++) {
+        writeEnergy(100 * i, 1000 * i, 2000 * i);
+        std::vector<EnergyMeasurement> measurements;
+        ASSERT_TRUE(meter->readEnergyMeter({1, 0}, &measurements).isOk());
+        ASSERT_EQ(measurements.size(), 2);
+        EXPECT_EQ(measurements[0].id, 1);
+        EXPECT_EQ(measurements[0].energyUWs, 2000 * i);
+        EXPECT_EQ(measurements[1].id, 0);
+        EXPECT_EQ(measurements[1].energyUWs, 1000 * i);
+    }
+    EXPECT_EQ(mReads, 3);
+}
+
+TEST_F(CoalescedEnergyMeterDataProviderTest, RejectsUnknownChannel) {
+    auto meter = makeMeter(1h);
+    writeEnergy(100, 1000, 2000);
+    std::vector<EnergyMeasurement> measurements;
+    const ndk::ScopedAStatus status = meter->readEnergyMeter({0, 2}, &measurements);
+    EXPECT_EQ(status.getExceptionCode(), EX_ILLEGAL_ARGUMENT);
+    EXPECT_TRUE(measurements.empty());
+}
+
+TEST_F(CoalescedEnergyMeterDataProviderTest, FailedReadIsNotCached) {
+    auto meter = makeMeter(1h);
+    std::vector<EnergyMeasurement> measurements;
+    EXPECT_FALSE(meter->readEnergyMeter({}, &measurements).isOk());
+
+    writeEnergy(100, 1000, 2000);
+    ASSERT_TRUE(meter->readEnergyMeter({}, &measurements).isOk());
+    EXPECT_EQ(measurements.size(), 2);
+    EXPECT_EQ(mReads, 2);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <CpuTopology.h>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include <sys/stat.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+class CpuTopologyTest : public ::testing::Test {
+  protected:
+    void addPolicy(int policy, const std::string &relatedCpus) {
+        const std::string dir = std::string(mDir.path) + "/policy" + std::to_string(policy);
+        ASSERT_EQ(mkdir(dir.c_str(), 0755), 0);
+        ASSERT_TRUE(::android::base::WriteStringToFile(relatedCpus + "\n", dir + "/related_cpus"));
+    }
+
+    TemporaryDir mDir;
+    CpuTopology mTopology;
+};
+
+TEST_F(CpuTopologyTest, OrdersClustersByFirstCpu) {
+    addPolicy(8, "8");
+    addPolicy(0, "3 2 1 0");
+    addPolicy(4, "4 5 6 7");
+    ASSERT_TRUE(mTopology.discover(mDir.path));
+
+    const std::vector<CpuTopology::Cluster> &clusters = mTopology.getClusters();
+    ASSERT_EQ(clusters.size(), 3);
+    EXPECT_EQ(clusters[0].cpus, std::vector<uint32_t>({0, 1, 2, 3}));
+    EXPECT_EQ(clusters[1].cpus, std::vector<uint32_t>({4, 5, 6, 7}));
+    EXPECT_EQ(clusters[2].cpus, std::vector<uint32_t>({8}));
+    EXPECT_EQ(clusters[1].policyDir, std::string(mDir.path) + "/policy4");
+    EXPECT_EQ(CpuTopology::getCoreName(1, 3), "CORE13");
+}
+
+TEST_F(CpuTopologyTest, AcceptsMaxCoresPerCluster) {
+    addPolicy(0, "0 1 2 3 4 5 6 7 8 9");
+    ASSERT_TRUE(mTopology.discover(mDir.path));
+    EXPECT_EQ(mTopology.getClusters()[0].cpus.size(), CpuTopology::kMaxCoresPerCluster);
+}
+
+TEST_F(CpuTopologyTest, RejectsClusterWithAmbiguousCoreNames) {
+    // Core 10 of cluster 1 would be named like core 0 of cluster 11.
+    addPolicy(0, "0");
+    addPolicy(1, "1 2 3 4 5 6 7 8 9 10 11");
+    EXPECT_FALSE(mTopology.discover(mDir.path));
+    EXPECT_TRUE(mTopology.getClusters().empty());
+}
+
+TEST_F(CpuTopologyTest, FailsWithoutPolicies) {
+    EXPECT_FALSE(mTopology.discover(mDir.path));
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <FileUtils.h>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+class FileUtilsTest : public ::testing::Test {
+  protected:
+    void writeFile(size_t size) {
+        ASSERT_TRUE(::android::base::WriteStringToFile(std::string(size, 'x'), mFile.path));
+    }
+
+    TemporaryFile mFile;
+    // Bytes already in the buffer, which every read appends after.
+    std::vector<char> mBuffer = std::vector<char>(3, 'p');
+    size_t mUsed = 3;
+};
+
+TEST_F(FileUtilsTest, ReadsFileOfMaxSize) {
+    writeFile(kMaxFileSize);
+    ASSERT_TRUE(readFileToBuffer(mFile.path, &mBuffer, &mUsed));
+    EXPECT_EQ(mUsed, 3 + kMaxFileSize);
+    EXPECT_EQ(std::string(mBuffer.data(), 4), "pppx");
+}
+
+TEST_F(FileUtilsTest, FailsOnFileOverMaxSize) {
+    writeFile(kMaxFileSize + 1);
+    errno = 0;
+    EXPECT_FALSE(readFileToBuffer(mFile.path, &mBuffer, &mUsed));
+    EXPECT_EQ(errno, EFBIG);
+    EXPECT_EQ(mUsed, 3);
+    // The buffer does not grow much past the limit to find out.
+    EXPECT_LE(mBuffer.size(), 3 + kMaxFileSize + 1);
+}
+
+TEST_F(FileUtilsTest, CachedFileFailsOnFileOverMaxSize) {
+    CachedFile file(mFile.path);
+    writeFile(16);
+    ASSERT_TRUE(file.read(&mBuffer, &mUsed));
+    EXPECT_EQ(mUsed, 3 + 16);
+
+    mUsed = 3;
+    writeFile(kMaxFileSize + 1);
+    errno = 0;
+    EXPECT_FALSE(file.read(&mBuffer, &mUsed));
+    EXPECT_EQ(errno, EFBIG);
+    EXPECT_EQ(mUsed, 3);
+}
+
+TEST_F(FileUtilsTest, CachedFileRecoversOnceFileShrinks) {
+    CachedFile file(mFile.path);
+    writeFile(kMaxFileSize + 1);
+    EXPECT_FALSE(file.read(&mBuffer, &mUsed));
+
+    writeFile(16);
+    ASSERT_TRUE(file.read(&mBuffer, &mUsed));
+    EXPECT_EQ(mUsed, 3 + 16);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <Gs201PowerStats.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using namespace std::chrono_literals;
+
+// Two power entities with one state each, whose residency grows on every read.
+class FakeStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    explicit FakeStateResidencyDataProvider(std::atomic<int> *reads) : mReads(reads) {}
+
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override {
+        const int read = ++*mReads;
+        residencies->emplace("A", std::vector<StateResidency>{{.id = 0,
+                                                               .totalTimeInStateMs = read}});
+        residencies->emplace("B", std::vector<StateResidency>{{.id = 0,
+                                                               .totalTimeInStateMs = 2 * read}});
+        return true;
+    }
+
+    std::unordered_map<std::string, std::vector<State>> getInfo() override {
+        return {{"A", {{.id = 0, .name = "ON"}}}, {"B", {{.id = 0, .name = "ON"}}}};
+    }
+
+  private:
+    std::atomic<int> *const mReads;
+};
+
+// One power entity with one state, counting its reads.
+class SlowStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    explicit SlowStateResidencyDataProvider(std::atomic<int> *reads) : mReads(reads) {}
+
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override {
+        ++*mReads;
+        std::this_thread::sleep_for(100ms);
+        residencies->emplace("SLOW", std::vector<StateResidency>{{.id = 0}});
+        return true;
+    }
+
+    std::unordered_map<std::string, std::vector<State>> getInfo() override {
+        return {{"SLOW", {{.id = 0, .name = "ON"}}}};
+    }
+
+  private:
+    std::atomic<int> *const mReads;
+};
+
+class Gs201PowerStatsTest : public ::testing::Test {
+  protected:
+    std::shared_ptr<Gs201PowerStats> create(std::chrono::milliseconds coalesceWindow) {
+        std::shared_ptr<Gs201PowerStats> p =
+                ndk::SharedRefBase::make<Gs201PowerStats>(coalesceWindow);
+        p->addStateResidencyDataProvider(
+                std::make_unique<FakeStateResidencyDataProvider>(&mReads));
+        return p;
+    }
+
+    // Queries on another thread, so that a query that never returns fails the test instead of
+    // hanging it.
+    static bool query(std::shared_ptr<Gs201PowerStats> p, const std::vector<int32_t> &ids,
+                      std::vector<StateResidencyResult> *results) {
+        auto done = std::make_shared<std::promise<std::vector<StateResidencyResult>>>();
+        std::future<std::vector<StateResidencyResult>> future = done->get_future();
+        std::thread([p, ids, done] {
+            std::vector<StateResidencyResult> r;
+            if (p->getStateResidency(ids, &r).isOk()) {
+                done->set_value(std::move(r));
+            } else {
+                done->set_exception(std::make_exception_ptr(std::runtime_error("query failed")));
+            }
+        }).detach();
+        if (future.wait_for(5s) != std::future_status::ready) {
+            return false;
+        }
+        *results = future.get();
+        return true;
+    }
+
+    std::atomic<int> mReads = 0;
+};
+
+TEST_F(Gs201PowerStatsTest, CoalescedEmptyQueryReturnsEveryEntity) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::vector<StateResidencyResult> results;
+    ASSERT_TRUE(query(p, {}, &results));
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].id, 0);
+    EXPECT_EQ(results[1].id, 1);
+}
+
+TEST_F(Gs201PowerStatsTest, CoalescedQueriesShareCollection) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::vector<StateResidencyResult> all;
+    std::vector<StateResidencyResult> one;
+    ASSERT_TRUE(query(p, {}, &all));
+    ASSERT_TRUE(query(p, {1}, &one));
+    EXPECT_EQ(mReads, 1);
+    ASSERT_EQ(one.size(), 1);
+    EXPECT_EQ(one[0], all[1]);
+}
+
+TEST_F(Gs201PowerStatsTest, ConcurrentCoalescedQueriesComplete) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::vector<std::future<bool>> queries;
+    for (int i = 0; i < 8; i++) {
+        queries.push_back(std::async(std::launch::async, [p, i] {
+            std::vector<StateResidencyResult> results;
+            return query(p, i % 2 ? std::vector<int32_t>{} : std::vector<int32_t>{0}, &results) &&
+                   results.size() == (i % 2 ? 2 : 1);
+        }));
+    }
+    for (std::future<bool> &q : queries) {
+        EXPECT_TRUE(q.get());
+    }
+    // The queries of every entity share one read, the others may each read their own.
+    EXPECT_GE(mReads, 1);
+    EXPECT_LE(mReads, 5);
+}
+
+TEST_F(Gs201PowerStatsTest, CoalescedNarrowQueryReadsOnlyItsEntities) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::atomic<int> slowReads = 0;
+    p->addStateResidencyDataProvider(std::make_unique<SlowStateResidencyDataProvider>(&slowReads));
+
+    std::vector<StateResidencyResult> results;
+    ASSERT_TRUE(query(p, {0}, &results));
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].id, 0);
+    EXPECT_EQ(mReads, 1);
+    EXPECT_EQ(slowReads, 0);
+
+    // Without a completed collection to share, the next narrow query reads again.
+    ASSERT_TRUE(query(p, {1}, &results));
+    EXPECT_EQ(mReads, 2);
+    EXPECT_EQ(slowReads, 0);
+}
+
+TEST_F(Gs201PowerStatsTest, CoalescedNarrowQueryDoesNotWaitForCollection) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::atomic<int> slowReads = 0;
+    p->addStateResidencyDataProvider(std::make_unique<SlowStateResidencyDataProvider>(&slowReads));
+
+    std::future<bool> all = std::async(std::launch::async, [p] {
+        std::vector<StateResidencyResult> results;
+        return query(p, {}, &results) && results.size() == 3;
+    });
+    while (slowReads == 0) {
+        std::this_thread::sleep_for(1ms);
+    }
+    // The collection of every entity is still reading SLOW.
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<StateResidencyResult> results;
+    ASSERT_TRUE(query(p, {0}, &results));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 80ms);
+    EXPECT_EQ(results.size(), 1);
+    EXPECT_TRUE(all.get());
+}
+
+TEST_F(Gs201PowerStatsTest, CoalescedEmptyQueryAppendsResults) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::vector<StateResidencyResult> results = {{.id = 42}};
+    ASSERT_TRUE(p->getStateResidency({}, &results).isOk());
+    ASSERT_EQ(results.size(), 3);
+    EXPECT_EQ(results[0].id, 42);
+    EXPECT_EQ(results[1].id, 0);
+    EXPECT_EQ(results[2].id, 1);
+}
+
+TEST_F(Gs201PowerStatsTest, CoalescedQueryRejectsUnknownEntity) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::vector<StateResidencyResult> results;
+    EXPECT_EQ(p->getStateResidency({2}, &results).getExceptionCode(), EX_ILLEGAL_ARGUMENT);
+}
+
+TEST_F(Gs201PowerStatsTest, UncoalescedQueriesReadEveryTime) {
+    std::shared_ptr<Gs201PowerStats> p = create(0ms);
+    std::vector<StateResidencyResult> results;
+    ASSERT_TRUE(query(p, {}, &results));
+    ASSERT_TRUE(query(p, {}, &results));
+    EXPECT_EQ(mReads, 2);
+}
+
+TEST_F(Gs201PowerStatsTest, CoalescedEmptyQueryIsRecorded) {
+    std::shared_ptr<Gs201PowerStats> p = create(1h);
+    std::vector<StateResidencyResult> results;
+    ASSERT_TRUE(query(p, {}, &results));
+
+    std::vector<StateResidencyResult> since;
+    p->getResidencySince(0, &since);
+    EXPECT_EQ(since, results);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
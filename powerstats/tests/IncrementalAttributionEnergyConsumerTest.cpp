@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <IncrementalAttributionEnergyConsumer.h>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr int32_t kNumUids = 300;
+
+// Meter with a single channel, whose energy is set by the test.
+class FakeEnergyMeterDataProvider : public PowerStats::IEnergyMeterDataProvider {
+  public:
+    explicit FakeEnergyMeterDataProvider(const int64_t *energyUWs) : mEnergyUWs(energyUWs) {}
+
+    ndk::ScopedAStatus readEnergyMeter(const std::vector<int32_t> &in_channelIds,
+                                       std::vector<EnergyMeasurement> *_aidl_return) override {
+        _aidl_return->push_back({.id = 0, .timestampMs = 1, .energyUWs = *mEnergyUWs});
+        return ndk::ScopedAStatus::ok();
+    }
+
+    ndk::ScopedAStatus getEnergyMeterInfo(std::vector<Channel> *_aidl_return) override {
+        *_aidl_return = {{.id = 0, .name = "S2S_VDD_G3D", .subsystem = "GPU"}};
+        return ndk::ScopedAStatus::ok();
+    }
+
+  private:
+    const int64_t *const mEnergyUWs;
+};
+
+/*
+ * Non-incremental form of the consumer: parses and weighs every row of every snapshot, and splits
+ * the energy measured since the previous snapshot the same way.
+ */
+class ReferenceAttribution {
+  public:
+    explicit ReferenceAttribution(std::map<std::string, int32_t> stateCoeffs)
+        : kStateCoeffs(std::move(stateCoeffs)) {}
+
+    void update(const std::vector<std::string> &states,
+                const std::map<int32_t, std::vector<uint64_t>> &rows, int64_t energyUWs) {
+        if (states != mStates) {
+            mStates = states;
+            mRows.clear();
+            mHasBaseline = false;
+        }
+
+        std::map<int32_t, int64_t> weights;
+        int64_t totalWeight = 0;
+        for (const auto &[uid, times] : rows) {
+            std::vector<uint64_t> &old = mRows[uid];
+            old.resize(times.size());
+            int64_t weight = 0;
+            for (size_t i = 0; i < times.size(); i++) {
+                const auto it = kStateCoeffs.find(mStates[i]);
+                if (mHasBaseline && times[i] > old[i] && it != kStateCoeffs.end()) {
+                    weight += static_cast<int64_t>(times[i] - old[i]) * it->second;
+                }
+                old[i] = times[i];
+            }
+            if (weight > 0) {
+                weights[uid] = weight;
+                totalWeight += weight;
+            }
+        }
+
+        // UIDs gone from the node are forgotten, along with the energy attributed to them.
+        for (auto it = mRows.begin(); it != mRows.end();) {
+            it = rows.count(it->first) ? std::next(it) : mRows.erase(it);
+        }
+
+        const int64_t deltaUWs = energyUWs - mLastEnergyUWs;
+        if (mHasBaseline && deltaUWs > 0 && totalWeight > 0) {
+            for (const auto &[uid, weight] : weights) {
+                mAttribution[uid] += static_cast<int64_t>(static_cast<__int128>(deltaUWs) *
+                                                          weight / totalWeight);
+            }
+        }
+        for (auto it = mAttribution.begin(); it != mAttribution.end();) {
+            it = rows.count(it->first) ? std::next(it) : mAttribution.erase(it);
+        }
+        mHasBaseline = true;
+        mLastEnergyUWs = energyUWs;
+    }
+
+    std::vector<EnergyConsumerAttribution> getAttribution() const {
+        std::vector<EnergyConsumerAttribution> attribution;
+        for (const auto &[uid, energyUWs] : mAttribution) {
+            attribution.push_back({.uid = uid, .energyUWs = energyUWs});
+        }
+        return attribution;
+    }
+
+  private:
+    const std::map<std::string, int32_t> kStateCoeffs;
+    std::vector<std::string> mStates;
+    std::map<int32_t, std::vector<uint64_t>> mRows;
+    bool mHasBaseline = false;
+    int64_t mLastEnergyUWs = 0;
+    std::map<int32_t, int64_t> mAttribution;
+};
+
+class IncrementalAttributionEnergyConsumerTest : public ::testing::Test {
+  protected:
+    const std::map<std::string, int32_t> kStateCoeffs = {
+            {"151000", 10}, {"302000", 25}, {"455000", 60}, {"848000", 200}};
+
+    IncrementalAttributionEnergyConsumerTest()
+        : mMeter(std::make_unique<FakeEnergyMeterDataProvider>(&mEnergyUWs), 0ms),
+          mConsumer(&mMeter, EnergyConsumerType::OTHER, "GPU", {"S2S_VDD_G3D"}, mPath,
+                    kStateCoeffs),
+          mReference(kStateCoeffs) {
+        for (int32_t uid = 10000; uid < 10000 + kNumUids; uid++) {
+            mRows[uid].assign(mStates.size(), 0);
+        }
+    }
+
+    void writeNode() {
+        std::string node = "uid:";
+        for (const std::string &state : mStates) {
+            node += " " + state;
+        }
+        node += "\n";
+        for (const auto &[uid, times] : mRows) {
+            node += std::to_string(uid) + ":";
+            for (uint64_t time : times) {
+                node += " " + std::to_string(time);
+            }
+            node += "\n";
+        }
+        ASSERT_TRUE(::android::base::WriteStringToFile(node, mPath));
+    }
+
+    // Queries the consumer and the reference, and checks they agree.
+    void queryAndCompare() {
+        writeNode();
+        mReference.update(mStates, mRows, mEnergyUWs);
+        const std::optional<EnergyConsumerResult> result = mConsumer.getEnergyConsumed();
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->energyUWs, mEnergyUWs);
+        EXPECT_EQ(result->attribution, mReference.getAttribution());
+    }
+
+    // Advances the times of a few UIDs and the energy of the meter.
+    void advance(std::mt19937 *rng, int numActive) {
+        std::uniform_int_distribution<size_t> rows(0, mRows.size() - 1);
+        std::uniform_int_distribution<size_t> states(0, mStates.size() - 1);
+        std::uniform_int_distribution<uint64_t> times(1, 5000);
+        for (int i = 0; i < numActive; i++) {
+            std::next(mRows.begin(), rows(*rng))->second[states(*rng)] += times(*rng);
+        }
+        mEnergyUWs += std::uniform_int_distribution<int64_t>(0, 10000000)(*rng);
+    }
+
+    TemporaryDir mDir;
+    const std::string mPath = std::string(mDir.path) + "/uid_time_in_state";
+    int64_t mEnergyUWs = 0;
+    CoalescedEnergyMeterDataProvider mMeter;
+    IncrementalAttributionEnergyConsumer mConsumer;
+    ReferenceAttribution mReference;
+    std::vector<std::string> mStates = {"151000", "302000", "455000", "848000"};
+    std::map<int32_t, std::vector<uint64_t>> mRows;
+};
+
+TEST_F(IncrementalAttributionEnergyConsumerTest, FirstQueryOnlySetsBaseline) {
+    std::mt19937 rng(1);
+    advance(&rng, 50);
+    writeNode();
+    const std::optional<EnergyConsumerResult> result = mConsumer.getEnergyConsumed();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->attribution.empty());
+}
+
+TEST_F(IncrementalAttributionEnergyConsumerTest, MatchesNonIncrementalAttribution) {
+    std::mt19937 rng(42);
+    queryAndCompare();
+    for (int i = 0; i < 200; i++) {
+        advance(&rng, i % 20);
+        queryAndCompare();
+    }
+    EXPECT_GT(mReference.getAttribution().size(), kNumUids / 2);
+}
+
+TEST_F(IncrementalAttributionEnergyConsumerTest, MatchesAcrossNewAndResetUids) {
+    std::mt19937 rng(7);
+    queryAndCompare();
+    for (int i = 0; i < 50; i++) {
+        advance(&rng, 10);
+        if (i % 10 == 3) {
+            // A new UID is installed with time already accumulated.
+            mRows[20000 + i] = {100, 200, 300, 400};
+        }
+        if (i % 10 == 6) {
+            // A UID is removed and reused, its counters start over.
+            mRows[10000 + i].assign(mStates.size(), 1);
+        }
+        queryAndCompare();
+    }
+}
+
+TEST_F(IncrementalAttributionEnergyConsumerTest, ForgetsUidsGoneFromNode) {
+    std::mt19937 rng(11);
+    queryAndCompare();
+    for (int i = 0; i < 50; i++) {
+        advance(&rng, 40);
+        if (i % 5 == 2) {
+            // An app is uninstalled, its row disappears.
+            mRows.erase(std::next(mRows.begin(), i));
+        }
+        if (i % 10 == 7) {
+            // A removed UID is reused and starts over.
+            mRows[10000 + i - 5] = {1, 2, 3, 4};
+        }
+        queryAndCompare();
+    }
+
+    const std::optional<EnergyConsumerResult> result = mConsumer.getEnergyConsumed();
+    ASSERT_TRUE(result.has_value());
+    for (const EnergyConsumerAttribution &attribution : result->attribution) {
+        EXPECT_EQ(mRows.count(attribution.uid), 1) << attribution.uid;
+    }
+}
+
+TEST_F(IncrementalAttributionEnergyConsumerTest, MatchesAfterStatesChange) {
+    std::mt19937 rng(3);
+    queryAndCompare();
+    advance(&rng, 30);
+    queryAndCompare();
+
+    // A new frequency table restarts the attribution from a new baseline.
+    mStates = {"151000", "302000", "455000", "572000", "848000"};
+    for (auto &[uid, times] : mRows) {
+        times.insert(times.begin() + 3, 0);
+    }
+    queryAndCompare();
+    for (int i = 0; i < 20; i++) {
+        advance(&rng, 10);
+        queryAndCompare();
+    }
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
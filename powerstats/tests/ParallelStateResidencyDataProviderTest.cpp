@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <ParallelStateResidencyDataProvider.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using namespace std::chrono_literals;
+
+// One power entity, named after the provider, whose reads take a given time.
+class FakeStateResidencyDataProvider : public PowerStats::IStateResidencyDataProvider {
+  public:
+    FakeStateResidencyDataProvider(std::string name, std::chrono::milliseconds latency)
+        : mName(std::move(name)), mLatency(latency) {}
+
+    bool getStateResidencies(
+            std::unordered_map<std::string, std::vector<StateResidency>> *residencies) override {
+        std::this_thread::sleep_for(mLatency);
+        const int read = ++mReads;
+        residencies->emplace(mName, std::vector<StateResidency>{{.id = 0,
+                                                                 .totalTimeInStateMs = read}});
+        return true;
+    }
+
+    std::unordered_map<std::string, std::vector<State>> getInfo() override {
+        return {{mName, {{.id = 0, .name = "ON"}}}};
+    }
+
+    int getReads() const { return mReads; }
+
+  private:
+    const std::string mName;
+    const std::chrono::milliseconds mLatency;
+    std::atomic<int> mReads = 0;
+};
+
+class ParallelStateResidencyDataProviderTest : public ::testing::Test {
+  protected:
+    // Registers one provider per latency through a group with the given deadline.
+    void addProviders(std::chrono::milliseconds deadline,
+                      const std::vector<std::chrono::milliseconds> &latencies) {
+        auto group = std::make_shared<ParallelStateResidencyDataProvider>(latencies.size(),
+                                                                          deadline);
+        for (size_t i = 0; i < latencies.size(); i++) {
+            auto provider = std::make_unique<FakeStateResidencyDataProvider>(
+                    std::string(1, 'A' + i), latencies[i]);
+            mProviders.push_back(provider.get());
+            mPowerStats->addStateResidencyDataProvider(group->addDataProvider(std::move(provider)));
+        }
+    }
+
+    std::vector<StateResidencyResult> query(const std::vector<int32_t> &ids) {
+        std::vector<StateResidencyResult> results;
+        EXPECT_TRUE(mPowerStats->getStateResidency(ids, &results).isOk());
+        return results;
+    }
+
+    std::shared_ptr<PowerStats> mPowerStats = ndk::SharedRefBase::make<PowerStats>();
+    std::vector<FakeStateResidencyDataProvider *> mProviders;
+};
+
+TEST_F(ParallelStateResidencyDataProviderTest, SingleEntityQueryReadsOnlyItsProvider) {
+    addProviders(1s, {0ms, 0ms, 0ms});
+    const std::vector<StateResidencyResult> results = query({1});
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].id, 1);
+    EXPECT_EQ(mProviders[0]->getReads(), 0);
+    EXPECT_EQ(mProviders[1]->getReads(), 1);
+    EXPECT_EQ(mProviders[2]->getReads(), 0);
+}
+
+TEST_F(ParallelStateResidencyDataProviderTest, FullQueryReadsProvidersConcurrently) {
+    addProviders(1s, {100ms, 100ms, 100ms, 100ms});
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(query({}).size(), 4);
+    // The first provider is read before the query is known to read them all.
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 350ms);
+    for (const FakeStateResidencyDataProvider *provider : mProviders) {
+        EXPECT_EQ(provider->getReads(), 1);
+    }
+}
+
+TEST_F(ParallelStateResidencyDataProviderTest, SlowProviderOnlyDelaysItsOwnEntities) {
+    addProviders(50ms, {0ms, 500ms, 0ms});
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<StateResidencyResult> results = query({});
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 400ms);
+
+    // The slow provider has no result yet, the others are unaffected.
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].id, 0);
+    EXPECT_EQ(results[1].id, 2);
+}
+
+TEST_F(ParallelStateResidencyDataProviderTest, RecentReadsAreReused) {
+    addProviders(1s, {0ms, 0ms});
+    query({});
+    query({});
+    EXPECT_EQ(mProviders[0]->getReads(), 1);
+    EXPECT_EQ(mProviders[1]->getReads(), 1);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
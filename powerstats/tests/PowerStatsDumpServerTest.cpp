@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <PowerStatsDumpServer.h>
+#include <PowerStatsSnapshotFormat.h>
+#include <ProviderTelemetry.h>
+
+#include <android-base/file.h>
+#include <android-base/unique_fd.h>
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstring>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using ::android::base::unique_fd;
+
+// Not kDumpSocketName, which the service may already listen on.
+constexpr char kTestSocketName[] = "powerstats_dump_test";
+
+// Sends request as is and returns the whole reply, or "<failed>" if the request could not be sent.
+std::string request(std::string_view request) {
+    unique_fd fd(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path + 1, kTestSocketName, sizeof(kTestSocketName) - 1);
+    const socklen_t addrLength = offsetof(sockaddr_un, sun_path) + sizeof(kTestSocketName);
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr *>(&addr), addrLength) != 0 ||
+        !::android::base::WriteFully(fd, request.data(), request.size()) ||
+        shutdown(fd, SHUT_WR) != 0) {
+        return "<failed>";
+    }
+    std::string reply;
+    ::android::base::ReadFdToString(fd, &reply);
+    return reply;
+}
+
+class PowerStatsDumpServerTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        getProviderCounters("DumpServerTest")->record(std::chrono::microseconds(10), 0, 0, false,
+                                                      false);
+        mServer.start();
+    }
+
+    std::shared_ptr<PowerStats> mPowerStats = ndk::SharedRefBase::make<PowerStats>();
+    PowerStatsDumpServer mServer{mPowerStats.get(), kTestSocketName};
+};
+
+TEST_F(PowerStatsDumpServerTest, DumpsProviderCounters) {
+    const std::string reply = request(std::string("--providers") + '\0');
+    EXPECT_NE(reply.find("provider counters"), std::string::npos) << reply;
+    EXPECT_NE(reply.find("DumpServerTest"), std::string::npos) << reply;
+}
+
+TEST_F(PowerStatsDumpServerTest, DumpsProviderCountersWithoutArguments) {
+    EXPECT_NE(request("").find("DumpServerTest"), std::string::npos);
+}
+
+TEST_F(PowerStatsDumpServerTest, DumpsRailPower) {
+    const std::string reply = request(std::string("--power") + '\0' + "0" + '\0');
+    EXPECT_NE(reply.find("rail power from 0 to"), std::string::npos) << reply;
+    EXPECT_EQ(request(std::string("--power") + '\0' + "soon" + '\0'), "Invalid interval\n");
+}
+
+TEST_F(PowerStatsDumpServerTest, DumpsSnapshot) {
+    const std::string reply = request(std::string("--binary") + '\0');
+    ASSERT_GT(reply.size(), sizeof(snapshot::kMagic));
+    EXPECT_EQ(reply.compare(0, sizeof(snapshot::kMagic), snapshot::kMagic,
+                            sizeof(snapshot::kMagic)),
+              0);
+}
+
+TEST_F(PowerStatsDumpServerTest, RejectsBadRequests) {
+    EXPECT_EQ(request(std::string("--bogus") + '\0'), "Unknown arguments\n");
+    EXPECT_EQ(request("--providers"), "Malformed request\n");
+    EXPECT_EQ(request(std::string(kDumpMaxRequest + 1, '\0')), "Request too long\n");
+}
+
+TEST_F(PowerStatsDumpServerTest, ServesClientsInTurn) {
+    // A client that never finishes its request holds the server for at most kClientTimeout;
+    // later ones are still answered.
+    unique_fd idle(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path + 1, kTestSocketName, sizeof(kTestSocketName) - 1);
+    ASSERT_EQ(connect(idle, reinterpret_cast<const sockaddr *>(&addr),
+                      offsetof(sockaddr_un, sun_path) + sizeof(kTestSocketName)),
+              0);
+    EXPECT_NE(request("").find("DumpServerTest"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
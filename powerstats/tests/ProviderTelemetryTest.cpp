@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <FileUtils.h>
+#include <ProviderTelemetry.h>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+// Columns of a provider counters line.
+struct Counters {
+    uint64_t calls;
+    uint64_t bytesPerCall;
+    uint64_t failed;
+    uint64_t readErrors;
+    uint64_t parseErrors;
+};
+
+Counters getCounters(const ProviderCounters &counters) {
+    std::ostringstream oss;
+    counters.dump(oss);
+    std::istringstream iss(oss.str());
+    std::string name;
+    uint64_t avgUs, p50Us, p99Us;
+    Counters c = {};
+    iss >> name >> c.calls >> avgUs >> p50Us >> p99Us >> c.bytesPerCall >> c.failed >>
+            c.readErrors >> c.parseErrors;
+    return c;
+}
+
+class ProviderTelemetryTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(::android::base::WriteStringToFile(std::string(100, 'x'), mFile.path));
+    }
+
+    // Reads the file, or a file that does not exist.
+    bool read(bool exists = true) {
+        std::vector<char> buffer;
+        size_t used = 0;
+        return readFileToBuffer(exists ? mFile.path : std::string(mFile.path) + ".missing",
+                                &buffer, &used);
+    }
+
+    TemporaryFile mFile;
+};
+
+TEST_F(ProviderTelemetryTest, BytesAreChargedToTheCallOnTheReadingThread) {
+    ProviderCounters caller("caller");
+    ProviderCounters reader("reader");
+    {
+        ScopedProviderCall call(&caller);
+        std::thread([&] {
+            ScopedProviderCall readerCall(&reader);
+            read();
+        }).join();
+    }
+    EXPECT_EQ(getCounters(caller).bytesPerCall, 0);
+    EXPECT_EQ(getCounters(reader).bytesPerCall, 100);
+}
+
+TEST_F(ProviderTelemetryTest, NestedCallsAreBothCharged) {
+    ProviderCounters outer("outer");
+    ProviderCounters inner("inner");
+    {
+        ScopedProviderCall outerCall(&outer);
+        read();
+        ScopedProviderCall innerCall(&inner);
+        read();
+    }
+    EXPECT_EQ(getCounters(outer).bytesPerCall, 200);
+    EXPECT_EQ(getCounters(inner).bytesPerCall, 100);
+}
+
+TEST_F(ProviderTelemetryTest, ReadsOutsideCallsAreNotCounted) {
+    ProviderCounters counters("counters");
+    read();
+    { ScopedProviderCall call(&counters); }
+    EXPECT_EQ(getCounters(counters).calls, 1);
+    EXPECT_EQ(getCounters(counters).bytesPerCall, 0);
+}
+
+TEST_F(ProviderTelemetryTest, FailedReadIsNotAParseError) {
+    ProviderCounters counters("counters");
+    {
+        ScopedProviderCall call(&counters);
+        read();
+        read(false);
+        call.setFailed();
+    }
+    const Counters c = getCounters(counters);
+    EXPECT_EQ(c.failed, 1);
+    EXPECT_EQ(c.readErrors, 1);
+    EXPECT_EQ(c.parseErrors, 0);
+}
+
+TEST_F(ProviderTelemetryTest, FailureAfterSuccessfulReadsIsAParseError) {
+    ProviderCounters counters("counters");
+    {
+        ScopedProviderCall call(&counters);
+        read();
+        call.setFailed();
+    }
+    const Counters c = getCounters(counters);
+    EXPECT_EQ(c.failed, 1);
+    EXPECT_EQ(c.readErrors, 0);
+    EXPECT_EQ(c.parseErrors, 1);
+}
+
+TEST_F(ProviderTelemetryTest, FailureWithoutReadsIsNotClassified) {
+    ProviderCounters counters("counters");
+    {
+        ScopedProviderCall call(&counters);
+        call.setFailed();
+    }
+    const Counters c = getCounters(counters);
+    EXPECT_EQ(c.failed, 1);
+    EXPECT_EQ(c.readErrors, 0);
+    EXPECT_EQ(c.parseErrors, 0);
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl
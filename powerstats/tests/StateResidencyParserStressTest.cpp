@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2026 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <AcpmDvfsStateResidencyDataProvider.h>
+#include <AcpmStatsSnapshot.h>
+#include <BufferedStateResidencyDataProvider.h>
+#include <FileUtils.h>
+#include <Gs201PowerEntityTables.h>
+#include <PowerEntityTable.h>
+#include <StateResidencyParser.h>
+
+#include <android-base/file.h>
+#include <gtest/gtest.h>
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Bytes allocated by the calling thread, to bound the memory a single parse asks for.
+static thread_local size_t tAllocatedBytes = 0;
+
+void *operator new(size_t size) {
+    tAllocatedBytes += size;
+    if (void *p = malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+namespace aidl {
+namespace android {
+namespace hardware {
+namespace power {
+namespace stats {
+namespace {
+
+using namespace std::chrono_literals;
+
+// A linear pass over kMaxFileSize takes milliseconds even with sanitizers; a quadratic one takes
+// minutes. Measured in thread CPU time, so that the threads sharing a core do not count.
+constexpr std::chrono::milliseconds kMaxParseTime = 500ms;
+// The buffer a node is read into doubles until it holds the node, so its allocations add up to
+// less than four times the node. The rest, mostly the residencies returned, is small.
+constexpr size_t kBufferAllocationsPerByte = 4;
+constexpr size_t kMaxParseOverhead = 64 * 1024;
+constexpr size_t kPathologicalSize = 256 * 1024;
+constexpr int kNumThreads = 4;
+
+// The tables of every node parsed with StateResidencyParser in Gs201CommonDataProviders.cpp.
+const std::vector<TableRef<PowerEntityTable>> kTables = {
+        gs201::kSocEntities,        gs201::kCpuEntities,       gs201::kPowerDomainEntities,
+        gs201::kAocRestartEntities, gs201::kModemEntities,     gs201::kGnssEntities,
+        gs201::kPcieModemEntities,  gs201::kPcieWifiEntities,  gs201::kWifiEntities,
+        gs201::kNfcEntities,
+};
+
+std::chrono::nanoseconds threadCpuTime() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+// A node every state of configs can be parsed from.
+std::string buildNode(const std::vector<StateResidencyParser::PowerEntityConfig> &configs) {
+    std::string node;
+    for (const auto &entity : configs) {
+        if (!entity.mHeader.empty()) {
+            node += entity.mHeader + "\n";
+        }
+        for (const auto &state : entity.mStateResidencyConfigs) {
+            if (!state.header.empty()) {
+                node += state.header + "\n";
+            }
+            if (state.entryCountSupported) {
+                node += "  " + state.entryCountPrefix + " 5\n";
+            }
+            if (state.totalTimeSupported) {
+                node += "  " + state.totalTimePrefix + " 1000\n";
+            }
+            if (state.lastEntrySupported) {
+                node += "  " + state.lastEntryPrefix + " 7\n";
+            }
+        }
+    }
+    return node;
+}
+
+// Repeats pattern until it fills size bytes.
+std::string repeat(const std::string &pattern, size_t size) {
+    std::string out;
+    out.reserve(size);
+    while (out.size() + pattern.size() <= size) {
+        out += pattern;
+    }
+    return out;
+}
+
+// Malformed, truncated and oversized variants of a valid node.
+std::vector<std::string> buildInputs(const std::string &valid, std::mt19937 *rng) {
+    std::vector<std::string> inputs;
+    for (size_t cut : {size_t(1), valid.size() / 3, valid.size() / 2, valid.size() - 1}) {
+        inputs.push_back(valid.substr(0, cut));
+    }
+    // Every line header, none followed by what it announces.
+    std::string headers;
+    for (size_t pos = 0; pos < valid.size();) {
+        const size_t end = valid.find('\n', pos);
+        const std::string line = valid.substr(pos, end - pos);
+        if (line.find_first_of("0123456789") == std::string::npos) {
+            headers += line + "\n";
+        }
+        pos = end + 1;
+    }
+    inputs.push_back(repeat(headers.empty() ? "\n" : headers, kPathologicalSize));
+    inputs.push_back(repeat(valid, kPathologicalSize));
+    inputs.push_back(std::string(kPathologicalSize, 'x'));
+    inputs.push_back(std::string(kPathologicalSize, ' '));
+    inputs.push_back(std::string(kPathologicalSize, '\n'));
+    inputs.push_back(repeat(" 99999999999999999999999999999999\n", kPathologicalSize));
+    std::string garbage(kPathologicalSize, '\0');
+    std::generate(garbage.begin(), garbage.end(), [rng] { return static_cast<char>((*rng)()); });
+    inputs.push_back(garbage);
+    inputs.push_back(valid + std::string(kMaxFileSize, ' '));
+    return inputs;
+}
+
+class StateResidencyParserStressTest : public ::testing::Test {
+  protected:
+    // Runs query on every input from every thread, checking the time and memory of each call.
+    // prepare runs before each query, unmeasured.
+    template <typename Prepare, typename Query>
+    void stress(const std::vector<std::string> &inputs, Prepare prepare, Query query) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kNumThreads; t++) {
+            threads.emplace_back([&, t] {
+                for (size_t i = 0; i < inputs.size(); i++) {
+                    const std::string &input = inputs[(i + t) % inputs.size()];
+                    prepare(t, input);
+                    const size_t allocatedBefore = tAllocatedBytes;
+                    const std::chrono::nanoseconds start = threadCpuTime();
+                    query(t, input);
+                    const std::chrono::nanoseconds elapsed = threadCpuTime() - start;
+                    const size_t allocated = tAllocatedBytes - allocatedBefore;
+                    EXPECT_LE(elapsed, kMaxParseTime) << "input of " << input.size() << " bytes";
+                    EXPECT_LE(allocated, kBufferAllocationsPerByte *
+                                                         std::min(input.size(), kMaxFileSize) +
+                                                 kMaxParseOverhead)
+                            << "input of " << input.size() << " bytes";
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::mt19937 mRng{42};
+};
+
+TEST_F(StateResidencyParserStressTest, ParsesValidNodes) {
+    for (const TableRef<PowerEntityTable> &table : kTables) {
+        const StateResidencyParser parser(buildPowerEntityConfigs(table));
+        std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+        EXPECT_TRUE(parser.parse(buildNode(buildPowerEntityConfigs(table)), &residencies))
+                << table.begin()->name;
+        EXPECT_EQ(residencies.size(), table.size());
+    }
+}
+
+TEST_F(StateResidencyParserStressTest, SharedParsersAreBounded) {
+    for (const TableRef<PowerEntityTable> &table : kTables) {
+        SCOPED_TRACE(table.begin()->name);
+        const StateResidencyParser parser(buildPowerEntityConfigs(table));
+        const std::string valid = buildNode(buildPowerEntityConfigs(table));
+        std::vector<std::string> inputs = buildInputs(valid, &mRng);
+        inputs.push_back(valid);
+        stress(inputs, [](int, const std::string &) {}, [&](int, const std::string &input) {
+            std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+            const bool parsed = parser.parse(input, &residencies);
+            if (input == valid) {
+                EXPECT_TRUE(parsed);
+            }
+        });
+    }
+}
+
+TEST_F(StateResidencyParserStressTest, BufferedProvidersAreBounded) {
+    for (const TableRef<PowerEntityTable> &table : kTables) {
+        SCOPED_TRACE(table.begin()->name);
+        const std::string valid = buildNode(buildPowerEntityConfigs(table));
+        const std::vector<std::string> inputs = buildInputs(valid, &mRng);
+        // Each thread reads its own node through its own provider.
+        std::vector<TemporaryFile> files(kNumThreads);
+        std::vector<std::unique_ptr<BufferedStateResidencyDataProvider>> providers;
+        for (const TemporaryFile &file : files) {
+            providers.push_back(std::make_unique<BufferedStateResidencyDataProvider>(
+                    file.path, buildPowerEntityConfigs(table)));
+        }
+        stress(
+                inputs,
+                [&](int t, const std::string &input) {
+                    ASSERT_TRUE(::android::base::WriteStringToFile(input, files[t].path));
+                },
+                [&](int t, const std::string &input) {
+                    std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+                    const bool read = providers[t]->getStateResidencies(&residencies);
+                    // Oversized nodes fail with EFBIG, valid prefixes of them are not parsed.
+                    if (input.size() > kMaxFileSize) {
+                        EXPECT_FALSE(read);
+                    }
+                });
+    }
+}
+
+TEST_F(StateResidencyParserStressTest, DvfsProvidersAreBounded) {
+    // fvp_stats is parsed by hand rather than with StateResidencyParser. A truncated copy of a
+    // plausible node is enough to walk its error paths.
+    const std::string valid = repeat(
+            "CL0\n 2401000 12345 100 7\n CL1\n 2802000 999 5 3\nTPU\n 1066000 77 1 2\n", 4096);
+    const std::vector<std::string> inputs = buildInputs(valid, &mRng);
+    std::vector<TemporaryDir> dirs(kNumThreads);
+    std::vector<std::unique_ptr<AcpmDvfsStateResidencyDataProvider>> providers;
+    for (const TemporaryDir &dir : dirs) {
+        providers.push_back(std::make_unique<AcpmDvfsStateResidencyDataProvider>(
+                std::make_shared<AcpmStatsSnapshot>(std::string(dir.path) + "/"), 1000000,
+                buildDvfsConfigs(gs201::kDvfsEntities)));
+    }
+    stress(
+            inputs,
+            [&](int t, const std::string &input) {
+                ASSERT_TRUE(::android::base::WriteStringToFile(
+                        input, std::string(dirs[t].path) + "/fvp_stats"));
+            },
+            [&](int t, const std::string &input) {
+                std::unordered_map<std::string, std::vector<StateResidency>> residencies;
+                const bool read = providers[t]->getStateResidencies(&residencies);
+                if (input.size() > kMaxFileSize) {
+                    EXPECT_FALSE(read);
+                }
+            });
+}
+
+}  // namespace
+}  // namespace stats
+}  // namespace power
+}  // namespace hardware
+}  // namespace android
+}  // namespace aidl